@@ -0,0 +1,172 @@
+// AutoCompleter.cpp : the most frequent completions of any prefix, from a trie of TracNodes
+
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "AutoCompleter.hpp"
+
+AutoCompleter::AutoCompleter(const TracNode *root, uint maxK) : mRoot(root), mMaxK(maxK > 0 ? maxK : 1), mSlots(sMinSlots, 0)
+{
+    rankCompletions(mRoot);
+    std::vector<const TracNode *>().swap(mCandidates);
+}
+
+/** Post-order: each node's list is made from its children's, once all of theirs are made. */
+void AutoCompleter::rankCompletions(const TracNode *node)
+{
+    const CharMap& charMap = node->mCharMap;
+    uint numChildren = 0;
+    const TracNode *onlyChild = NULL;
+    for (uint j = charMap.targetBegIdx(), endIdx = charMap.targetEndIdx(); j < endIdx; j++) {
+        const TracNode *child = (const TracNode *)node->mBranches[j];
+        if (child != NULL) {
+            rankCompletions(child);
+            onlyChild = child;
+            numChildren++;
+        }
+    }
+    bool isWord = node->mWordCount > 0;
+    if ( ! isWord && numChildren == 1) {
+        const TopList& childList = findTopList(onlyChild);
+        addTopList(node, childList.mTopIdx, childList.mTopNum);    // the same completions, so the same list
+        return;
+    }
+
+    // The words under this node, in trie order (a word before its extensions),
+    // then ordered by count, with ties left in trie order.
+    mCandidates.clear();
+    if (isWord)
+        mCandidates.push_back(node);
+    for (uint j = charMap.targetBegIdx(), endIdx = charMap.targetEndIdx(); j < endIdx; j++) {
+        const TracNode *child = (const TracNode *)node->mBranches[j];
+        if (child != NULL) {
+            const TopList& childList = findTopList(child);
+            mCandidates.insert(mCandidates.end(), mLists.begin() + childList.mTopIdx, mLists.begin() + childList.mTopIdx + childList.mTopNum);
+        }
+    }
+    std::stable_sort(mCandidates.begin(), mCandidates.end(), isMoreFrequent);
+    uint numTop = mCandidates.size() < mMaxK ? (uint)mCandidates.size() : mMaxK;
+    addTopList(node, (uint)mLists.size(), numTop);
+    mLists.insert(mLists.end(), mCandidates.begin(), mCandidates.begin() + numTop);
+}
+
+void AutoCompleter::addTopList(const TracNode *node, uint topIdx, uint topNum)
+{
+    TopList list = { node, topIdx, topNum };
+    mTopLists.push_back(list);
+    uint mask = (uint)mSlots.size() - 1;
+    uint slot = hashNode(node) & mask;
+    while (mSlots[slot] != 0)
+        slot = (slot + 1) & mask;
+    mSlots[slot] = (uint)mTopLists.size();
+    if (mTopLists.size() * 2 > mSlots.size())
+        grow();
+}
+
+/** Double the slots, and put every list back in them, as TextWordCounts::grow does. */
+void AutoCompleter::grow()
+{
+    std::vector<uint>(mSlots.size() * 2, 0).swap(mSlots);
+    uint mask = (uint)mSlots.size() - 1;
+    for (uint idx = 0; idx < mTopLists.size(); idx++) {
+        uint slot = hashNode(mTopLists[idx].mNode) & mask;
+        while (mSlots[slot] != 0)
+            slot = (slot + 1) & mask;
+        mSlots[slot] = idx + 1;
+    }
+}
+
+const TracNode * AutoCompleter::findStem(const char *prefix) const
+{
+    const CharMap& charMap = mRoot->mCharMap;
+    const TracNode *node = mRoot;
+    for (const char *pc = prefix; *pc != '\0'; pc++) {
+        uchr uc = *pc;
+        if (uc < charMap.sourceMinChar() || charMap.sourceMaxChar() < uc)
+            return NULL;
+        uint ix = charMap.charToIndex(uc);
+        if (ix < charMap.targetBegIdx() || charMap.targetEndIdx() <= ix)
+            return NULL;
+        node = (const TracNode *)node->mBranches[ix];
+        if (node == NULL)
+            return NULL;
+    }
+    return node;
+}
+
+uint AutoCompleter::complete(const char *prefix, const TracNode *completions[]) const
+{
+    const TracNode *node = findStem(prefix);
+    if (node == NULL)
+        return 0;
+    const TopList& list = findTopList(node);
+    if (list.mTopNum == 0)
+        return 0;
+    const TracNode * const *top = &mLists[0] + list.mTopIdx;
+    for (uint j = 0; j < list.mTopNum; j++)
+        completions[j] = top[j];
+    return list.mTopNum;
+}
+
+uint AutoCompleter::completeAll(const char * const prefixes[], uint numPrefixes, const TracNode *completions[], uint numCompletions[]) const
+{
+    uint total = 0;
+    for (uint j = 0; j < numPrefixes; j++) {
+        numCompletions[j] = complete(prefixes[j], completions + j*mMaxK);
+        total += numCompletions[j];
+    }
+    return total;
+}
+
+char * AutoCompleter::copyWord(const TracNode *node, char *buf)
+{
+    uint depth = node->getDepth();
+    memcpy(buf, node->getStem(), depth);        // the stem may be a longer word
+    buf[depth] = '\0';
+    return buf;
+}
+
+int AutoCompleter::test_AutoCompleter(const TracNode *root, int verbosity)
+{
+    AutoCompleter autoCompleter(root);
+    const uint maxK = autoCompleter.getMaxK();
+    printf("AutoCompleter: %lu completions listed for top %u\n", (unsigned long)autoCompleter.getNumListed(), maxK);
+
+    const char *samples[] = { "", "a", "th", "qu", "pre", "zz" };
+    const uint numSamples = sizeof(samples)/sizeof(samples[0]);
+    std::vector<const TracNode *> completions(numSamples * maxK);
+    std::vector<uint> numCompletions(numSamples);
+    autoCompleter.completeAll(samples, numSamples, &completions[0], &numCompletions[0]);
+    char word[256];
+    for (uint j = 0; j < numSamples; j++) {
+        printf("  %-4s:", samples[j]);
+        for (uint k = 0; k < numCompletions[j]; k++)
+            printf(" %s", copyWord(completions[j*maxK + k], word));
+        printf("\n");
+    }
+
+    // Time a batch of every two-letter prefix, many times over.
+    if (verbosity > 1) {
+        static char pairs[26*26][3];
+        const char *prefixes[26*26];
+        for (uint j = 0; j < 26*26; j++) {
+            pairs[j][0] = (char)('a' + j/26);
+            pairs[j][1] = (char)('a' + j%26);
+            pairs[j][2] = '\0';
+            prefixes[j] = pairs[j];
+        }
+        std::vector<const TracNode *> batch(26*26*maxK);
+        std::vector<uint> batchNums(26*26);
+        const uint numReps = 1000;
+        uint total = 0;
+        clock_t begClock = clock();
+        for (uint rep = 0; rep < numReps; rep++)
+            total += autoCompleter.completeAll(prefixes, 26*26, &batch[0], &batchNums[0]);
+        double seconds = (double)(clock() - begClock) / CLOCKS_PER_SEC;
+        printf("AutoCompleter: %u queries, %u completions, %.1f ns per query\n"
+            , numReps*26*26, total, seconds * 1.0e9 / (numReps*26*26));
+    }
+    return 0;
+}
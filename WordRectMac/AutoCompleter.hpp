@@ -0,0 +1,105 @@
+// AutoCompleter.hpp : the most frequent completions of any prefix, from a trie of TracNodes
+
+#ifndef AutoCompleter_hpp
+#define AutoCompleter_hpp
+
+#include <vector>
+
+#include "TracNode.hpp"
+
+/**
+*   Answers "what are the K most frequent words that start with this prefix?" from a
+*   WordTrie<MapT, TracNode>, ranking words by their mWordCount (how many times each was
+*   read, from the dictionary or texts) and breaking ties in trie order.
+*
+*   The answers for every node are worked out once, bottom up, and kept in one flat array:
+*   a node's list is the best K among itself and its children's lists.  A node that is not
+*   a word and has only one child shares that child's list, so chains of single branches
+*   (the usual case below the first few chars) cost nothing.  The start and length of each
+*   node's list are kept here, in a hash table from node to list, not in the nodes, so any
+*   number of AutoCompleters, with their own K, can share one trie, and each can answer
+*   queries in several threads at once.  A query is a walk down the prefix, one lookup,
+*   and a copy of at most K pointers.
+*
+*   The counts are read when the AutoCompleter is made; words added or read after that
+*   are not seen until it is made again.
+*/
+class AutoCompleter
+{
+public:
+    static const uint sDefaultK = 10;
+
+    /** Work out the top maxK completions for every node under root. */
+    AutoCompleter(const TracNode *root, uint maxK = sDefaultK);
+    AutoCompleter(const AutoCompleter&);            // Prevent pass-by-value by not defining this copy constructor.
+    AutoCompleter& operator=(const AutoCompleter&); // Prevent assignment by not defining this operator.
+    ~AutoCompleter() { }
+
+    /**
+    * Put the word-nodes of the (up to maxK) most frequent completions of prefix into
+    * completions, most frequent first, and return how many there are.  A prefix that is
+    * itself a word is one of its own completions.
+    */
+    uint        complete(const char *prefix, const TracNode *completions[]) const;
+
+    /**
+    * Complete numPrefixes prefixes at once: the completions of prefixes[j] go into
+    * completions[j*getMaxK() ...] and their number into numCompletions[j].  Returns the
+    * total number of completions.
+    */
+    uint        completeAll(const char * const prefixes[], uint numPrefixes, const TracNode *completions[], uint numCompletions[]) const;
+
+    /** The node for prefix, or NULL if no word starts with it. */
+    const TracNode * findStem(const char *prefix) const;
+
+    /** Copy the word of a word-node into buf (at least depth+1 chars), and return buf. */
+    static char     * copyWord(const TracNode *node, char *buf);
+
+    inline uint     getMaxK()           const { return mMaxK; }
+    inline size_t   getNumListed()      const { return mLists.size(); }
+
+    // unit test function
+    static int test_AutoCompleter(const TracNode *root, int verbosity);
+
+private:
+    /** Where a node's most frequent completions are in mLists. */
+    struct TopList
+    {
+        const TracNode    * mNode;
+        uint                mTopIdx;            // where they start
+        uint                mTopNum;            // how many there are
+    };
+
+    void        rankCompletions(const TracNode *node);
+    void        addTopList(const TracNode *node, uint topIdx, uint topNum);
+    void        grow();
+    static bool isMoreFrequent(const TracNode *a, const TracNode *b) { return a->mWordCount > b->mWordCount; }
+
+    /** The list of a node under mRoot; every one has a list, once the constructor is done. */
+    const TopList& findTopList(const TracNode *node) const
+    {
+        uint mask = (uint)mSlots.size() - 1;
+        for (uint slot = hashNode(node) & mask; ; slot = (slot + 1) & mask) {
+            const TopList& list = mTopLists[mSlots[slot] - 1];
+            if (list.mNode == node)
+                return list;
+        }
+    }
+
+    /** Fibonacci hashing of the node's address: its high bits are the best mixed. */
+    static inline uint hashNode(const TracNode *node)
+    {
+        return (uint)(((uint64)(size_t)node * 0x9E3779B97F4A7C15ULL) >> 32);
+    }
+
+    static const uint       sMinSlots = 1 << 12;    // must be a power of 2
+
+    const TracNode        * mRoot;
+    const uint              mMaxK;
+    std::vector<const TracNode *> mLists;   // every node's top completions, each list contiguous
+    std::vector<TopList>    mTopLists;      // one per node
+    std::vector<uint>       mSlots;         // open addressing with linear probing: each slot holds the index of a TopList plus one
+    std::vector<const TracNode *> mCandidates;
+};
+
+#endif // AutoCompleter_hpp
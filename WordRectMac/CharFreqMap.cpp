@@ -1,6 +1,9 @@
 // CharFreqMap.cpp : trie nodes for word tries,
 
 #include "CharFreqMap.hpp"
+#include "CodePointMap.hpp"
+#include "WordListFile.hpp"
+#include "WordScanner.hpp"
 #include "wordPlatform.h"
 
 #include <algorithm>
@@ -30,6 +33,25 @@ int CharFreqMap::initFromFile(uint minCharCount, uint minWordLength, uint maxWor
     return decideDefaultCharMapType();
 }
 
+int CharFreqMap::initFromWordList(const WordListFile& wordList, uint minCharCount, int verbosity)
+{
+    mMinFoundWordLength = wordList.getMinFoundWordLength();
+    mMaxFoundWordLength = wordList.getMaxFoundWordLength();
+    const uint *charCounts = wordList.getCharCounts();
+    for (uint j = sBegChar; j <= sEndChar; j++)
+        mCharCounts[j] = charCounts[j];
+    if (wordList.getNumWords() < 100 || mMaxFoundWordLength < mMinWordLength) {  // same thresholds as countWordCharsInFile
+        printf("WARNING: No words or chars read from file <%s>\n", mFileSpec);
+        return -1;
+    }
+    initCharFreqPairs();
+    if (initRangeFromMinCharCount(minCharCount, verbosity) < 1) {
+        printf("WARNING: No words or chars read from file <%s>\n", mFileSpec);
+        return -1;
+    }
+    return decideDefaultCharMapType();
+}
+
 uint CharFreqMap::countWordCharsInFile(const char *fileSpec, uint minCharCount, uint minWordLength, uint maxWordLength, int verbosity)
 {
     uint numWordsCounted = countRawCharFreqs(fileSpec, mCharCounts, minWordLength, maxWordLength, mMinFoundWordLength, mMaxFoundWordLength);
@@ -145,7 +167,7 @@ uint CharFreqMap::initRangeFromMinCharCount(uint minCharCount, int verbosity)
                 }
                 cutoffPrinted = true;
             }
-            printf("%3d\t%c\t%d\n", idx, it->mChar, it->mFreq);
+            printf("%3d\t%s\t%d\n", idx, CodePointMap::getText(it->mChar), it->mFreq);
         }
     }
 
@@ -161,15 +183,8 @@ uint CharFreqMap::initRangeFromMinCharCount(uint minCharCount, int verbosity)
 uint CharFreqMap::extractFirstWord(char *line)
 {
     assert(line != NULL);
-    register char *ptrSigned = line;            // pointer to signed char
-    for ( ; ; ++ptrSigned) {
-        register uchr valUnsigned = *ptrSigned; // value as unsigned char
-        if (valUnsigned <= sBegChar) {
-            *ptrSigned = NULL;
-            break;
-        }
-    }
-    uint   length = uint(ptrSigned - line);   // pointer arithmetic
+    uint   length = uint(WordScanner::findSpace(line, line + strlen(line)) - line);   // pointer arithmetic
+    line[length] = '\0';
     return length;
 }
 
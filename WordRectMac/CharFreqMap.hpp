@@ -9,6 +9,8 @@
 
 #include <vector>
 
+class WordListFile;
+
 struct CharFreq {
     CharFreq(uchr c, int n) : mFreq(n), mChar(c) {}
     uint    mFreq;
@@ -65,6 +67,9 @@ public:
     uint getRangeCountOverMin(uint minCount) const;
 
     int    initFromFile(uint minCharCount, uint minWordLength, uint maxWordLength, int verbosity);
+
+    /** Same as initFromFile, but with the counts already made while reading the words (see WordListFile). */
+    int    initFromWordList(const WordListFile& wordList, uint minCharCount, int verbosity);
     CharMap::SubType getDefaultCharMapSubType()	const { return  mDefaultSubType; }
 
     // Factory methods (and helpers) for making a CharMap
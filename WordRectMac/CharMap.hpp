@@ -52,6 +52,8 @@ public:
         }
     }
 
+    virtual ~CharMap() { }  // Virtual, because sub-classes with virtual methods, such as CharPosMap, are deleted through pointers.
+
 #if USE_BASE_CHAR_MAP
 	// Sub-classes must override this virtual method, preferably with an in-line.
     // When called through a concrete subclass that is known at compile time, 
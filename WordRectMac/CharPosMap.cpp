@@ -0,0 +1,77 @@
+// CharPosMap.cpp : a CharMap with a compact map of char index to branch slot for each position in words of one length
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "CharPosMap.hpp"
+#include "CharFreqMap.hpp"
+#include "CodePointMap.hpp"
+
+CharPosMap::CharPosMap(const CharMap& charMap, uint wordLength)
+    : CharMap(charMap.targetBegIdx(), charMap.targetEndIdx(), charMap.sourceMinChar(), charMap.sourceMaxChar())
+    , mWordLength(wordLength), mStride(charMap.targetEndIdx())
+    , mCounts(wordLength * mStride, 0), mSlots((wordLength + 1) * mStride, 0), mNumSlots(wordLength + 1, 1)
+{
+    memset(mCharToIndex, 0, sizeof(mCharToIndex));
+    memset(mIndexToChar, 0, sizeof(mIndexToChar));
+    for (uint uc = charMap.sourceMinChar(); uc <= charMap.sourceMaxChar(); uc++) {
+        uint ix = charMap.charToIndex((uchr)uc);
+        mCharToIndex[uc] = ix;
+        if (ix < mStride && mIndexToChar[ix] == 0)
+            mIndexToChar[ix] = (uchr)uc;
+    }
+}
+
+void CharPosMap::addWord(const char *word)
+{
+    const uchr *pc = (const uchr *)word;
+    uint pos = 0;
+    for ( ; pos < mWordLength && pc[pos] != '\0'; pos++) {
+        if (pc[pos] < sourceMinChar() || sourceMaxChar() < pc[pos] || mCharToIndex[pc[pos]] >= mStride)
+            return;
+    }
+    if (pos < mWordLength || pc[pos] != '\0')
+        return;
+    for (pos = 0; pos < mWordLength; pos++)
+        mCounts[pos * mStride + mCharToIndex[pc[pos]]]++;
+}
+
+uint CharPosMap::initSlots()
+{
+    uint totalSlots = 0;
+    std::vector<CharFreq> freqs;
+    for (uint pos = 0; pos < mWordLength; pos++) {
+        freqs.clear();
+        for (uint ix = targetBegIdx(); ix < mStride; ix++) {
+            if (getCount(pos, ix) > 0)
+                freqs.push_back(CharFreq((uchr)ix, getCount(pos, ix)));     // index, not char
+        }
+        std::stable_sort(freqs.begin(), freqs.end(), CharFreqGreater());
+        uchr *slots = &mSlots[pos * mStride];
+        for (uint j = 0; j < freqs.size(); j++)
+            slots[freqs[j].mChar] = (uchr)(j + 1);
+        mNumSlots[pos] = (uint)freqs.size() + 1;
+        totalSlots += mNumSlots[pos];
+    }
+    return totalSlots;
+}
+
+void CharPosMap::printSlots() const
+{
+    printf("CharPosMap for %d-letter words: slots per position, most frequent char first\n", mWordLength);
+    for (uint pos = 0; pos < mWordLength; pos++) {
+        const uchr *slots = getSlots(pos);
+        printf("%3d %3d ", pos, getNumSlots(pos) - 1);
+        for (uint slot = 1; slot < getNumSlots(pos); slot++) {
+            for (uint ix = targetBegIdx(); ix < mStride; ix++) {
+                if (slots[ix] == slot) {
+                    printf(" %s", CodePointMap::getText(mIndexToChar[ix]));
+                    break;
+                }
+            }
+        }
+        printf("\n");
+    }
+}
@@ -0,0 +1,63 @@
+// CharPosMap.hpp : a CharMap with a compact map of char index to branch slot for each position in words of one length
+
+#ifndef CharPosMap_hpp
+#define CharPosMap_hpp
+
+#include <vector>
+
+#include "CharMap.hpp"
+
+/**
+*   A TrixNode has a branch for every index of its trie's CharMap, though most of them are NULL:
+*   in a fixed-length English trie, the average node has about two children out of 26 slots, and
+*   the leaves (half the nodes) have none.  But the chars at each position of a word are far
+*   from uniform: few words end in j, q, or v, and at depth 1 of a 6-letter trie nearly every
+*   child is a vowel.
+*
+*   A CharPosMap counts the chars at each position of the words of one length, as CharFreqMap
+*   does for a whole word list, and gives each position its own map from char index to branch
+*   slot: slot 0 for chars that no word has there, then 1, 2, ... for the others, most frequent
+*   first.  A TryNode at depth d then needs only getNumSlots(d) branches, with its slot 0 always
+*   NULL, so a lookup is two reads and no test.  Nodes at the last depth need no branches at all.
+*
+*   It maps chars to the same indices as the CharMap it is made from, so it can stand in for
+*   that map as a trie's CharMap.  Add all the words, then call initSlots, before making any
+*   nodes.  Words with a char not seen at some position cannot go in a trie of TryNodes.
+*/
+class CharPosMap : public CharMap
+{
+public:
+    /** Use the indices of charMap, for words of wordLength chars. */
+    CharPosMap(const CharMap& charMap, uint wordLength);
+    CharPosMap(const CharPosMap&);              // Prevent pass-by-value by not defining this copy constructor.
+    CharPosMap& operator=(const CharPosMap&);   // Prevent assignment by not defining this operator.
+
+    /** Count each char of word, which must be wordLength chars long (else it is ignored), at its position. */
+    void                addWord(const char *word);
+
+    /** Give each position's chars their slots, most frequent first.  Returns the total number of slots. */
+    uint                initSlots();
+
+    inline uint         charToIndex(uchr uc)            const { return mCharToIndex[uc]; }
+    inline uint         getWordLength()                 const { return mWordLength; }
+    inline uint         getCount(uint pos, uint ix)     const { return mCounts[pos * mStride + ix]; }
+
+    /** The slot of each char index at position pos (or 0 for all, past the last position). */
+    inline const uchr * getSlots(uint pos)              const { return &mSlots[(pos < mWordLength ? pos : mWordLength) * mStride]; }
+
+    /** How many branches a node at depth pos needs, counting the NULL slot 0 (so 1 if it has no children). */
+    inline uint         getNumSlots(uint pos)           const { return mNumSlots[pos < mWordLength ? pos : mWordLength]; }
+
+    void                printSlots()                    const;
+
+private:
+    uint                mCharToIndex[256];
+    uchr                mIndexToChar[256];  // for printing
+    const uint          mWordLength;
+    const uint          mStride;        // charMap.targetEndIdx(): one count and one slot per index, per position
+    std::vector<uint>   mCounts;        // the number of words with index ix at pos is mCounts[pos * mStride + ix]
+    std::vector<uchr>   mSlots;         // same layout, plus one more row of 0s for depth mWordLength
+    std::vector<uint>   mNumSlots;      // per position, plus 1 for depth mWordLength
+};
+
+#endif // CharPosMap_hpp
@@ -0,0 +1,155 @@
+// CodePointMap.cpp : one byte for each letter of a UTF-8 word list, so multi-byte alphabets fit the byte-indexed tries
+
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "CodePointMap.hpp"
+
+char CodePointMap::sText[sNumCodes][sMaxTextLen];
+bool CodePointMap::sTextReset = CodePointMap::resetText();
+
+bool CodePointMap::resetText()
+{
+    for (uint c = 0; c < sNumCodes; c++) {
+        sText[c][0] = (char)c;
+        sText[c][1] = '\0';
+    }
+    return true;
+}
+
+uint CodePointMap::charLength(const uchr *pc, const uchr *end)
+{
+    uint length, minCodePoint;
+    if (*pc < 0x80)
+        return 1;
+    else if (*pc < 0xC2)
+        return 0;               // a continuation byte, or the lead of an overlong 2-byte char
+    else if (*pc < 0xE0)
+        length = 2, minCodePoint = 0x80;
+    else if (*pc < 0xF0)
+        length = 3, minCodePoint = 0x800;
+    else if (*pc < 0xF5)
+        length = 4, minCodePoint = 0x10000;
+    else
+        return 0;
+    if (end - pc < (ptrdiff_t)length)
+        return 0;
+    for (uint j = 1; j < length; j++) {
+        if ((pc[j] & 0xC0) != 0x80)
+            return 0;
+    }
+    uint codePoint = codePointAt(pc, length);
+    if (codePoint < minCodePoint || codePoint > 0x10FFFF || (0xD800 <= codePoint && codePoint < 0xE000))
+        return 0;               // overlong, too big, or a surrogate
+    return length;
+}
+
+uint CodePointMap::codePointAt(const uchr *pc, uint length)
+{
+    static const uchr leadMasks[5] = { 0, 0x7F, 0x1F, 0x0F, 0x07 };
+    uint codePoint = pc[0] & leadMasks[length];
+    for (uint j = 1; j < length; j++)
+        codePoint = (codePoint << 6) | (pc[j] & 0x3F);
+    return codePoint;
+}
+
+static bool isMoreFrequent(const std::pair<uint, uint>& a, const std::pair<uint, uint>& b)
+{
+    return a.second > b.second || (a.second == b.second && a.first < b.first);
+}
+
+bool CodePointMap::init(const char *text, size_t size)
+{
+    mIsActive = false;
+    mNumUnmapped = 0;
+    mCodes.clear();
+    resetText();
+
+    // Count the multi-byte chars, by code point, giving up on the first invalid byte.
+    std::map<uint, uint> counts;
+    std::map<uint, const uchr *> firstSeen;
+    const uchr *end = (const uchr *)text + size;
+    for (const uchr *pc = (const uchr *)text; pc < end; ) {
+        if (*pc < 0x80) {
+            pc++;
+            continue;
+        }
+        uint length = charLength(pc, end);
+        if (length == 0)
+            return false;
+        uint codePoint = codePointAt(pc, length);
+        if (counts[codePoint]++ == 0)
+            firstSeen[codePoint] = pc;
+        pc += length;
+    }
+    if (counts.empty())
+        return false;
+
+    // Most frequent first, so if there are too many, only the rarest go without.
+    std::vector< std::pair<uint, uint> > byFreq(counts.begin(), counts.end());
+    std::sort(byFreq.begin(), byFreq.end(), isMoreFrequent);
+    uint code = sBegCode;
+    for (size_t j = 0; j < byFreq.size(); j++) {
+        if (code >= sEndCode) {
+            mNumUnmapped = (uint)(byFreq.size() - j);
+            break;
+        }
+        uint codePoint = byFreq[j].first;
+        const uchr *pc = firstSeen[codePoint];
+        uint length = charLength(pc, end);
+        memcpy(sText[code], pc, length);
+        sText[code][length] = '\0';
+        mCodes[codePoint] = (uchr)code++;
+    }
+    mIsActive = true;
+    return true;
+}
+
+int CodePointMap::encode(char *word, uint length, bool keepUnmapped) const
+{
+    if ( ! mIsActive)
+        return (int)length;
+
+    // First make sure every char has a code, so a word that cannot be encoded is left as it was.
+    const uchr *beg = (const uchr *)word, *end = beg + length;
+    for (const uchr *pc = keepUnmapped ? end : beg; pc < end; ) {
+        if (*pc < 0x80) {
+            pc++;
+            continue;
+        }
+        uint charLen = charLength(pc, end);
+        if (charLen == 0 || mCodes.find(codePointAt(pc, charLen)) == mCodes.end())
+            return -1;
+        pc += charLen;
+    }
+    uchr *out = (uchr *)word;
+    for (const uchr *pc = beg; pc < end; ) {
+        if (*pc < 0x80) {
+            *out++ = *pc++;
+            continue;
+        }
+        uint charLen = charLength(pc, end);
+        std::map<uint, uchr>::const_iterator it = charLen > 0 ? mCodes.find(codePointAt(pc, charLen)) : mCodes.end();
+        *out++ = it != mCodes.end() ? it->second : (uchr)sEndCode;
+        pc += charLen > 0 ? charLen : 1;
+    }
+    *out = '\0';
+    return (int)(out - (uchr *)word);
+}
+
+char * CodePointMap::decode(const char *word, char *buf, size_t bufSize)
+{
+    size_t pos = 0;
+    for (const uchr *pc = (const uchr *)word; *pc != '\0'; pc++) {
+        const char *text = sText[*pc];
+        size_t textLen = strlen(text);
+        if (pos + textLen >= bufSize)
+            break;
+        memcpy(buf + pos, text, textLen);
+        pos += textLen;
+    }
+    buf[pos] = '\0';
+    return buf;
+}
@@ -0,0 +1,86 @@
+// CodePointMap.hpp : one byte for each letter of a UTF-8 word list, so multi-byte alphabets fit the byte-indexed tries
+
+#ifndef CodePointMap_hpp
+#define CodePointMap_hpp
+
+#include <stddef.h>
+#include <map>
+
+#include "wordTypes.h"
+
+/**
+*   The tries, CharFreqMap, and every CharMap index words by unsigned char, so a UTF-8 word
+*   list would give them the bytes of each letter instead of the letter: "über" would be a
+*   5-char word, and Russian words would branch on lead bytes shared by half the alphabet.
+*
+*   A CodePointMap counts the code points in a UTF-8 text and gives each of the non-ASCII ones
+*   a byte code of its own, from sBegCode up, most frequent first.  encode then rewrites a
+*   word in place, one byte per letter, so from then on the word is just like an English one:
+*   its length is its number of letters, CharFreqMap counts letters, and the Compact and
+*   FreqFirst CharMaps make the trie fanout as small as the alphabet, in the same order of
+*   frequency.  ASCII chars keep their own values.  Text that is not valid UTF-8, or has no
+*   multi-byte chars, is left as is (each byte its own char, as before).
+*
+*   There are sEndCode - sBegCode codes.  Words with rarer letters than that many cannot be
+*   encoded, and encode rejects them.  That is plenty for German, French, or Russian, even
+*   with capitals, but not for Chinese.
+*
+*   The codes are only for the inside of the program; anything that prints letters or words
+*   must decode them with getText or decode.  Those use the map most recently made by init,
+*   since there is only one dictionary per run.
+*/
+class CodePointMap
+{
+public:
+    static const uint sNumCodes   = 256;
+    static const uint sBegCode    = 0x80;   // first code for a non-ASCII code point
+    static const uint sEndCode    = 0xFF;   // same as CharFreqMap::sEndChar: never a char
+    static const uint sMaxTextLen = 5;      // the longest UTF-8 char, plus a NULL
+
+    CodePointMap() : mIsActive(false), mNumUnmapped(0) { }
+    CodePointMap(const CodePointMap&);              // Prevent pass-by-value by not defining this copy constructor.
+    CodePointMap& operator=(const CodePointMap&);   // Prevent assignment by not defining this operator.
+
+    /**
+    * Count the code points in text[0, size) and give each non-ASCII one a code.  Returns true
+    * if the text is UTF-8 with at least one multi-byte char; otherwise maps nothing and returns
+    * false, and encode leaves words as they are.
+    */
+    bool                init(const char *text, size_t size);
+
+    /** Is there anything to encode? */
+    inline bool         isActive()          const   { return mIsActive; }
+
+    /** How many distinct code points were too rare to get a code. */
+    inline uint         getNumUnmapped()    const   { return mNumUnmapped; }
+
+    /**
+    * Rewrite the length bytes of word, in place, as one code per char, and NULL-terminate it.
+    * Returns its new length, or -1 (with word left as it was) if it has a char without a code.
+    * But if keepUnmapped is true, as for a word or pattern to look up, each char without a
+    * code becomes sEndCode, which is in no word, and the word is always encoded.
+    */
+    int                 encode(char *word, uint length, bool keepUnmapped = false) const;
+
+    /** The UTF-8 text of code c (for ASCII, or if no map is active, c itself). */
+    static inline const char * getText(uchr c) { return sText[c]; }
+
+    /** Copy the UTF-8 text of the codes in word to buf (of bufSize bytes), and return buf. */
+    static char       * decode(const char *word, char *buf, size_t bufSize);
+
+    /** Length in bytes of the UTF-8 char starting at pc (of at most end - pc bytes), or 0 if not valid. */
+    static uint         charLength(const uchr *pc, const uchr *end);
+
+private:
+    static uint         codePointAt(const uchr *pc, uint length);
+    static bool         resetText();
+
+    bool                mIsActive;
+    uint                mNumUnmapped;
+    std::map<uint, uchr> mCodes;            // code for each mapped code point
+
+    static char         sText[sNumCodes][sMaxTextLen];
+    static bool         sTextReset;
+};
+
+#endif // CodePointMap_hpp
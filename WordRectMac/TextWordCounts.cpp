@@ -0,0 +1,103 @@
+// TextWordCounts.cpp : how many times each word occurs in a text, counted without a trie
+
+#include <stdio.h>
+
+#include "wordPlatform.h"
+#include "TextWordCounts.hpp"
+#include "WordScanner.hpp"
+
+struct CountWordsArgs
+{
+    const char        * mText;
+    size_t              mSize;
+    const bool        * mIsWordChar;
+    uint                mMinWordLength;
+    uint                mMaxWordLength;
+    TextWordCounts    * mCounts;
+};
+
+/** Count the words in one slice of a block.  Runs in a worker thread. */
+static void countSliceWords(void *pvArgs)
+{
+    const CountWordsArgs *args = (const CountWordsArgs *)pvArgs;
+    WordScanner scanner(args->mIsWordChar);
+    scanner.reset(args->mText, args->mSize);
+    const char *word;
+    uint length;
+    while (scanner.nextWord(word, length)) {
+        if (args->mMinWordLength <= length && length <= args->mMaxWordLength)
+            args->mCounts->add(word, length);
+    }
+}
+
+long TextWordCounts::countWordsInFile(const char *fileSpec, const bool isWordChar[], uint minWordLength, uint maxWordLength
+    , std::vector<TextWordCounts>& counts)
+{
+    FILE *fi;
+    if (fopen_safe(&fi, fileSpec, "rb") != 0)
+        return -1;
+
+    long fileSize = -1;
+    if (fseek(fi, 0, SEEK_END) == 0) {
+        fileSize = ftell(fi);
+        if (fseek(fi, 0, SEEK_SET) != 0) {
+            fclose(fi);
+            return -1;
+        }
+    }
+
+    // 4 MB per thread, but for a file smaller than that, just each thread's share of it,
+    // plus a byte, so the whole file is read and scanned in one pass.
+    const uint   numSlices = counts.size() > 0 ? (uint)counts.size() : 1;
+    size_t       sliceSize = (size_t)1 << 22;
+    if (fileSize >= 0 && (size_t)fileSize / numSlices + 1 < sliceSize)
+        sliceSize = (size_t)fileSize / numSlices + 1;
+    const size_t blockSize = sliceSize * numSlices;
+    char        *block = new char[blockSize];
+    std::vector<CountWordsArgs> sliceArgs(numSlices);
+    std::vector<void *> sliceArgPtrs(numSlices);
+    long   numBytesRead = 0;
+    size_t carried = 0;
+    for (bool atEnd = false; ! atEnd; ) {
+        size_t numRead = fread(block + carried, 1, blockSize - carried, fi);
+        size_t size = carried + numRead;
+        numBytesRead += (long)numRead;
+        atEnd = (size < blockSize);
+
+        // Scan only up to the last space, carrying the rest over (as in addAllWordsInTextFile),
+        // and cut that into slices just before a space, so every run is in one slice.
+        size_t scanSize = size;
+        if ( ! atEnd) {
+            while (scanSize > 0 && (uchr)block[scanSize - 1] > ' ')
+                scanSize--;
+            if (scanSize == 0)
+                scanSize = size;
+        }
+        const char *sliceBeg = block, *scanEnd = block + scanSize;
+        for (uint t = 0; t < numSlices; t++) {
+            const char *sliceEnd = scanEnd;
+            if (t + 1 < numSlices) {
+                const char *nominal = block + scanSize * (t + 1) / numSlices;
+                sliceEnd = WordScanner::findSpace(nominal < sliceBeg ? sliceBeg : nominal, scanEnd);
+            }
+            sliceArgs[t].mText          = sliceBeg;
+            sliceArgs[t].mSize          = sliceEnd - sliceBeg;
+            sliceArgs[t].mIsWordChar    = isWordChar;
+            sliceArgs[t].mMinWordLength = minWordLength;
+            sliceArgs[t].mMaxWordLength = maxWordLength;
+            sliceArgs[t].mCounts        = &counts[t];
+            sliceArgPtrs[t] = &sliceArgs[t];
+            sliceBeg = sliceEnd;
+        }
+        if (numSlices > 1)
+            runWorkerThreads(countSliceWords, &sliceArgPtrs[0], (int)numSlices);
+        else
+            countSliceWords(sliceArgPtrs[0]);
+
+        carried = size - scanSize;
+        memmove(block, block + scanSize, carried);
+    }
+    delete [] block;
+    fclose(fi);
+    return numBytesRead;
+}
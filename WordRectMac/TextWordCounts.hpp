@@ -0,0 +1,103 @@
+// TextWordCounts.hpp : how many times each word occurs in a text, counted without a trie
+
+#ifndef TextWordCounts_hpp
+#define TextWordCounts_hpp
+
+#include <string.h>
+#include <vector>
+
+#include "wordTypes.h"
+
+/**
+*   A hash table from words to their counts, for counting the words of a big text in
+*   several threads at once, each with its own table, before adding them to a trie in
+*   bulk (see WordTrie::addAllWordsInTextFile).  The words are copied, NULL-terminated,
+*   into one growing block of text, so the table never points into the text being read.
+*   Open addressing with linear probing; each slot holds the index of an entry plus one.
+*/
+class TextWordCounts
+{
+public:
+    TextWordCounts() : mSlots(sMinSlots, 0) { }
+
+    /** Count one more occurrence of word[0, length). */
+    void add(const char *word, uint length)
+    {
+        uint64 hash = hashWord(word, length);
+        uint mask = (uint)mSlots.size() - 1;
+        for (uint slot = (uint)hash & mask; ; slot = (slot + 1) & mask) {
+            uint idx = mSlots[slot];
+            if (idx == 0) {
+                Entry entry = { hash, (uint)mText.size(), length, 1 };
+                mText.insert(mText.end(), word, word + length);
+                mText.push_back('\0');
+                mEntries.push_back(entry);
+                mSlots[slot] = (uint)mEntries.size();
+                if (mEntries.size() * 2 > mSlots.size())
+                    grow();
+                return;
+            }
+            Entry& entry = mEntries[idx - 1];
+            if (entry.mHash == hash && entry.mLength == length && memcmp(&mText[entry.mOffset], word, length) == 0) {
+                entry.mCount++;
+                return;
+            }
+        }
+    }
+
+    /**
+    * Count the words of lengths in [minWordLength, maxWordLength] in a text file, as split
+    * by WordScanner with isWordChar, with one thread per element of counts, each adding to
+    * its own.  The file is read in blocks, and each block is cut at spaces into one slice
+    * per thread, so no word is split.  Returns the number of bytes read, or -1 if the file
+    * cannot be opened.
+    */
+    static long countWordsInFile(const char *fileSpec, const bool isWordChar[], uint minWordLength, uint maxWordLength
+        , std::vector<TextWordCounts>& counts);
+
+    inline uint         getNumWords()       const   { return (uint)mEntries.size(); }
+    inline const char * getWord(uint j)     const   { return &mText[mEntries[j].mOffset]; }
+    inline uint         getLength(uint j)   const   { return mEntries[j].mLength; }
+    inline uint         getCount(uint j)    const   { return mEntries[j].mCount; }
+
+private:
+    static const uint   sMinSlots = 1 << 12;    // must be a power of 2
+
+    struct Entry
+    {
+        uint64  mHash;
+        uint    mOffset;                        // into mText
+        uint    mLength;
+        uint    mCount;
+    };
+
+    /** 64-bit FNV-1a, as in WordRectResults, but over a span instead of up to a NULL. */
+    static inline uint64 hashWord(const char *word, uint length)
+    {
+        uint64 hash = 14695981039346656037ULL;
+        for (uint j = 0; j < length; j++) {
+            hash ^= (uchr)word[j];
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    void grow()
+    {
+        std::vector<uint> slots(mSlots.size() * 2, 0);
+        uint mask = (uint)slots.size() - 1;
+        for (uint idx = 1; idx <= mEntries.size(); idx++) {
+            uint slot = (uint)mEntries[idx - 1].mHash & mask;
+            while (slots[slot] != 0)
+                slot = (slot + 1) & mask;
+            slots[slot] = idx;
+        }
+        mSlots.swap(slots);
+    }
+
+    std::vector<uint>   mSlots;
+    std::vector<Entry>  mEntries;
+    std::vector<char>   mText;
+};
+
+#endif // TextWordCounts_hpp
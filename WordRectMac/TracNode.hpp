@@ -16,6 +16,7 @@ class TracNode : public TrieNode
 {
     template <typename MapT, typename NodeT>
     friend class WordTrie;
+    friend class AutoCompleter;
 
 protected:
 
@@ -39,6 +40,8 @@ public:
     inline virtual void readAsDictWord(TrieNode *prevWordNode)  { ++mStemCount; ++mWordCount; };
     inline virtual void readAsTextStem()                        { ++mTextCount; };
     inline virtual void readAsTextWord()                        { ++mTextCount; ++mWordCount; };
+    inline virtual void readAsDictStems(uint count)             { mStemCount += count; };
+    inline virtual void readAsDictWords(uint count)             { mStemCount += count; mWordCount += count; };
 
     // unit test function
     template <typename MapT, typename NodeT>
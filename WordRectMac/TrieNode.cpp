@@ -17,7 +17,7 @@ TrieNode::TrieNode(const CharMap &charMap, int depth, TrieNode *parent)
 
 TrieNode::~TrieNode() 
 { 
-    delete (mBranches + mCharMap.targetBegIdx()); 
+    free(mBranches + mCharMap.targetBegIdx()); 
 }
 
 
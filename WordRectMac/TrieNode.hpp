@@ -30,7 +30,7 @@
 //       word getWord()  { return this == mFirstWordNode ? mStem : NULL; }
 //       When a node is known to be a word-node, just use getStem() instead of getWord().
 
-// TODO: typedef AcWordTrie for Auto-complete.
+// For auto-completion, see AutoCompleter, which works on a WordTrie of TracNodes.
 
 #ifndef TrieNode_hpp
 #define TrieNode_hpp
@@ -58,6 +58,11 @@ protected:
     const uint       mDepth;  // level in the tree.  Note that stem[depth] is this node's letter.  This const int prevents generation of assignment operator (ok).
     const CharMap& mCharMap;
 
+    // For WordTrie: the branch for char index ix, and whether this node has a slot for it (it always does; a TryNode may not).
+    inline bool         hasBranchSlot(uint /*ix*/)  const { return true; }
+    inline TrieNode   *& branchAt(uint ix)                { return mBranches[ix]; }
+    inline TrieNode    * branchAt(uint ix)          const { return mBranches[ix]; }
+
 public:
     TrieNode(const CharMap &charMap, int depth, TrieNode *parent=NULL); // constructor
     TrieNode (const TrieNode&);                                         // Do not define.
@@ -85,6 +90,8 @@ public:
     inline virtual void readAsDictWord(TrieNode *prevWordNode)    { };
     inline virtual void readAsTextStem()    { };
     inline virtual void readAsTextWord()    { };
+    inline virtual void readAsDictStems(uint count) { };   // Same as readAsDictStem count times over
+    inline virtual void readAsDictWords(uint count) { };   // Same as readAsDictWord count times over
 
     const TrieNode * getNextBranchFromIndex(int index) const {
         assert(mBranches[index]);
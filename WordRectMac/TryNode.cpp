@@ -3,3 +3,60 @@
 
 #include "TryNode.hpp"
 
+#include <stdlib.h>
+
+TryNode *TryNode::sNoBranches[1] = { NULL };
+
+TryNode::TryNode(const CharMap &charMap, int depth, TryNode *parent)
+    : mFirstBranch(NULL), mNextBranch(NULL), mFirstWordNode(NULL), mParent(parent), mNextStemNode(NULL)
+    , mStem(NULL), mPosMap(parent != NULL ? parent->mPosMap : static_cast<const CharPosMap&>(charMap)), mDepth(depth)
+{
+    assert(parent != NULL || dynamic_cast<const CharPosMap *>(&charMap) != NULL);
+    mSlots = mPosMap.getSlots(depth);
+    uint numSlots = mPosMap.getNumSlots(depth);
+    mBranches = numSlots > 1 ? (TryNode**)calloc(numSlots, sizeof(TryNode*)) : sNoBranches;
+}
+
+TryNode::~TryNode()
+{
+    if (mBranches != sNoBranches)
+        free(mBranches);
+}
+
+void TryNode::readAsDictWord(TryNode *prevWordNode)
+{
+    // Same as TrixNode::readAsDictWord
+    if (prevWordNode != NULL) {
+        TryNode *nodeParent = this, *prevParent = prevWordNode, *nextChild = this;
+        // set next word and next stem for shallower nodes that don't already have these pointers set.
+        while (nodeParent->mFirstWordNode == NULL) {
+            nodeParent->mFirstWordNode = this;
+            nextChild = nodeParent;             // Next child of greatest common ancestor of prevWordNode and this new word node
+            nodeParent = nodeParent->getParent();
+            prevParent = prevParent->getParent();
+        }
+        for (TryNode *pwn = prevWordNode; pwn != prevParent; pwn = pwn->getParent()) {
+            assert(pwn != NULL);
+            pwn->mNextStemNode = nextChild;
+        }
+    } else {
+        for (TryNode *parent = this; parent != NULL; parent = parent->getParent()) {
+            if (parent->mFirstWordNode == NULL) {
+                parent->mFirstWordNode = this;
+                parent->mStem          = mStem;
+            } else {
+                break;				// all higher (shallower) nodes already point to words that precede this one
+            }
+        }
+    }
+}
+
+void TryNode::printWordsAll() const
+{
+    if (this == mFirstWordNode) {
+        printf("%s\n", mStem);
+    }
+    for (const TryNode *node = mFirstBranch; node != NULL; node = node->mNextBranch) {
+        node->printWordsAll();
+    }
+}
@@ -1,8 +1,8 @@
-// TryNode.hpp : A base class implementing trie nodes for word tries. 
+// TryNode.hpp : A node class for fixed-length word tries, with a compact branch array per node. 
 // The allowed chars need not be contiguous as numbers/indices.
-// The TryNode itself contains the mapping from chars to child indices,
-// and it may be different for distinct nodes.  The goal is to make
-// the maps small but adaptive.
+// Each TryNode gets the mapping from char indices to its branch slots from a CharPosMap,
+// which makes one such map per depth, so it may be different for nodes at distinct depths.
+// The goal is to make the maps small but adaptive.
 //
 // TODO: Consider maps A, B, C, D, and E, and try to use only B, C, D.
 // Regarding L as a letter or a "virtual" node, then:
@@ -14,6 +14,15 @@
 // 
 // Sprax Lines,  October 2012
 
+// Note: A TryNode has the same interface as a TrixNode, so the word rect finders can use either
+//       (see USE_TRY_NODES in WordTrie.hpp), but its trie's CharMap must be a CharPosMap, made
+//       from the words to be inserted.  Where a TrixNode has a branch for every index of the trie's
+//       CharMap, a TryNode at depth d has only as many as there are distinct chars at position d
+//       of the trie's words, plus one slot that is always NULL, for chars that are not there.
+//       Nodes at the last depth, which are half of all the nodes in a fixed-length trie, share
+//       one NULL slot and allocate nothing.  The cost is one more read per branch lookup, from
+//       mSlots, which is tiny and shared by all the nodes at the same depth.
+//       It has no virtual methods, so it cannot be sub-classed as TrieNode is by TracNode.
 
 #ifndef TryNode_hpp
 #define TryNode_hpp
@@ -21,7 +30,7 @@
 #include <stdio.h>
 
 #include "wordTypes.h"
-#include "CharMap.hpp"
+#include "CharPosMap.hpp"
 
 class TryNode
 {
@@ -30,44 +39,34 @@ class TryNode
 
 protected:
 
-    TryNode       **mBranches;     // all possible continuations...
-    const TryNode  *mFirstBranch;  // First non-NULL branch is the first node in the mBranches as a linked list
+    TryNode       **mBranches;      // The continuations, by slot: mBranches[mSlots[charIndex]].  mBranches[0] is always NULL.
+    const uchr     *mSlots;         // Slot of each char index at this depth (the same for all nodes at this depth)
+    const TryNode  *mFirstBranch;   // First non-NULL branch is the first node in the mBranches as a linked list
     const TryNode  *mNextBranch;	// Assumes fixed length; otherwise, the next branch depends on the desired word length
-    TryNode        *mParent;       // One level up in the trie tree is the node representing this stem's "prefix" (the string w/o last this one's last letter)
+    const TryNode  *mFirstWordNode;	// node of first word that completes this one's stem (this, if this is a word node)
+    TryNode        *mParent;        // One level up in the trie tree is the node representing this stem's "prefix" (the string w/o last this one's last letter)
+    TryNode        *mNextStemNode;	// node of first stem after this one 
 
 ////const char *mWord;  // The word, if this is a word node; NULL, if it is not a word node.  Used as a boolean and for printing.
     const char *mStem;  // Some word that completes this stem; only the first N chars matter, where N == depth.  But if the trie
         // is loaded in alphabetic order, then mStem == mFirstWordNode.mWord.  If other words are inserted later, it may be necessary
         // (and worthwhile in terms of performance) to maintain this identity by fixing up both mStem and/or mFirstWordNode, as needed.
-    const int  mDepth;  // level in the tree.  Note that stem[depth] is this node's letter.  This const int prevents generation of assignment operator (ok).
-    TryNode * mFirstWordNode;	// node of first word that completes this one's stem (this, if this is a word node)
-    TryNode * mNextStemNode;	// node of first stem after this one 
-    // TryNode * nextWordNode;	// node of first word that does not start with this one's stem.  Examples: 
-    //     For stem a, first word is aah, next stem is b, and next word is baa (not aba or aal); 
-    //     For ac, first word is ace, next stem is ad, and next word is add (not act);
-    //     For stem ace, first word is ace (itself), and the next stem & next word are the same: act.
-    //     mNextStemNode is more useful than nextWordNode.  Note that if a node's nextWordNode is not null, 
-    //     then node.nextWordNode == node.mNextStemNode.mFirstWordNode.  In practice, it may be more useful 
-    //     to go through the mNextStemNode rather than skipping directly to a mNextStemNode, because the
-    //     mNextStemNode, if it exists, carries additional information, such as its depth.
+    const CharPosMap &mPosMap;
+    const uint  mDepth; // level in the tree.  Note that stem[depth] is this node's letter.  This const int prevents generation of assignment operator (ok).
 
-public:
-
-    TryNode(const CharMap &charMap, int depth, TryNode *parent)              // constructor
-        : mFirstBranch(NULL), mNextBranch(NULL), mParent(parent)
-        ////, mWord(NULL)
-        , mStem(NULL)
-        , mDepth(depth), mFirstWordNode(NULL), mNextStemNode(NULL)
-        //, nextWordNode(NULL)
-    {
-        // mBranches = (TryNode**)calloc(charMap.targetSize(), sizeof(TryNode*)) - charMap.targetOffset();
-    };
+    static TryNode *sNoBranches[1]; // shared by all the nodes with no children at their depth
 
+    // For WordTrie: the branch for char index ix, and whether this node has a slot for it at all.
+    inline bool         hasBranchSlot(uint ix)  const { return mSlots[ix] != 0; }
+    inline TryNode   *& branchAt(uint ix)             { return mBranches[mSlots[ix]]; }
+    inline TryNode    * branchAt(uint ix)       const { return mBranches[mSlots[ix]]; }
 
+public:
 
-    TryNode (const TryNode&);                                                 // Do not define.
-    TryNode& operator=(const TryNode&);                                       // Do not define.
-    ~TryNode() { delete mBranches; }
+    TryNode(const CharMap &charMap, int depth, TryNode *parent=NULL);      // charMap must be a CharPosMap
+    TryNode (const TryNode&);                                               // Do not define.
+    TryNode& operator=(const TryNode&);                                     // Do not define.
+    ~TryNode();
 
 ////inline const char     * getWord()			const { return mWord; }			// NULL, if this is not a word-node
     inline const char     * getWord()			const { return this == mFirstWordNode ? mStem : NULL; }
@@ -75,51 +74,41 @@ public:
     inline const char     * getStem()           const { return mStem; }
     inline       uint       getDepth()			const { return mDepth; }
     inline		 uchr	    getLetter()			const { return mStem[mDepth]; }
-    inline		 uchr	    getLetterAt(int ix) const { return mStem[ix]; }
-    inline		 TryNode * getParent()			const { return mParent; }		// NULL, if this is a root node
-    inline const TryNode * getFirstChild()	    const { return mFirstBranch; }	
-    inline const TryNode * getNextBranch()	    const { return mNextBranch; }	
-    inline const TryNode * getFirstWordNode()	const { return mFirstWordNode; }	
-    inline const TryNode * getNextStemNode()   const {	return mNextStemNode; }
-    //	inline const TryNode * getNextWordNode()	const { return nextWordNode; }	// nextWordNode == mNextStemNode->mFirstWordNode, so we don't really need nextWordNode
-
-    // virtual methods.  An inline hint may be honored by the compiler if the actual class of the calling object is known at compile time.
-    inline virtual void readAsDictStem()    { };
-    inline virtual void readAsDictWord()    { };
-    inline virtual void readAsTextStem()    { };
-    inline virtual void readAsTextWord()    { };
-
-    inline const TryNode * getBranchAtIndex(int index) const {
-        return mBranches[index];    // may return NULL 
-    }
+    inline		 uchr	    getLetterAt(uint ix) const { return mStem[ix]; }
+    inline       uint       getIndexFromChar(uchr uc)   const { return mPosMap.charToIndex(uc); }
+    inline		 TryNode  * getParent()			const { return mParent; }		// NULL, if this is a root node
+    inline const TryNode  * getFirstChild()	    const { return mFirstBranch; }	
+    inline const TryNode  * getNextBranch()	    const { return mNextBranch; }	
+    inline const TryNode  * getFirstWordNode()	const { return mFirstWordNode; }	
+    inline const TryNode  * getNextStemNode()   const {	return mNextStemNode; }
+    inline const TryNode  * getBranchFromChar(uchr uc)  const { return branchAt(getIndexFromChar(uc)); }
+    inline const TryNode  * getBranchAtIndex(uint ux)   const { return branchAt(ux); }     // May return NULL 
+
+    // Call-backs from WordTrie.  TryNodes count nothing, and set only their links.
+    inline void readAsDictStem()                    { };
+    inline void readAsDictStems(uint /*count*/)     { };
+    inline void readAsDictWords(uint /*count*/)     { };
+    void        readAsDictWord(TryNode *prevWordNode);
+
     const TryNode * getNextBranchFromIndex(int index) const {
-        assert(mBranches[index]);
-        return mBranches[index]->mNextBranch; 
+        assert(branchAt(index));
+        return branchAt(index)->mNextBranch; 
     }
     inline const TryNode * getFirstWordNodeFromIndex(int index) const {
-        if (mBranches[index] != NULL) {
-            return mBranches[index]->mFirstWordNode;
+        const TryNode *branch = branchAt(index);
+        if (branch != NULL) {
+            return branch->mFirstWordNode;
         }
-        // Still here?  Expect few non-NULL mBranches, so use the links instead of the array indices
-        for (const TryNode *branch = mFirstBranch; branch != NULL; branch = branch->mNextBranch) {
-            if (branch->mStem[0] >= index) {
+        // Still here?  Then take the first branch after index, in the order of the links (which is by index, not slot)
+        for (branch = mFirstBranch; branch != NULL; branch = branch->mNextBranch) {
+            if (mPosMap.charToIndex(branch->mStem[mDepth]) >= (uint)index) {
                 return branch->mFirstWordNode;
             }
         }
         return NULL;
     }
 
-    void TryNode::printWordsAll() const
-    {
-        ////if (mWord != NULL) {
-        if (this == mFirstWordNode) {
-            printf("%s\n", mStem);
-        }
-        for (const TryNode *node = mFirstBranch; node != NULL; node = node->mNextBranch) {
-            node->printWordsAll();
-        }
-    }
-
+    void printWordsAll() const;
 };
 
-#endif // TryNode_hpp
\ No newline at end of file
+#endif // TryNode_hpp
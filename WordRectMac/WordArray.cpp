@@ -0,0 +1,146 @@
+// WordArray.cpp : the words of one length, sorted, back to back in one array, with fast prefix bounds
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "WordArray.hpp"
+
+namespace {
+    struct WordLess     // memcmp order, for words of one length
+    {
+        WordLess(uint length) : mLength(length) { }
+        inline bool operator()(const char *s1, const char *s2) const { return memcmp(s1, s2, mLength) < 0; }
+        uint mLength;
+    };
+}
+
+void WordArray::assign(const std::vector<const char *>& words, uint wordLength)
+{
+    mWordLength = wordLength;
+    mStride     = wordLength + 1;
+    mNumWords   = (uint)words.size();
+
+    std::vector<const char *> sorted(words);
+    std::sort(sorted.begin(), sorted.end(), WordLess(wordLength));
+    mChars.assign((size_t)mNumWords * mStride, '\0');
+    memset(mIsLetter, 0, sizeof(mIsLetter));
+    for (uint j = 0; j < mNumWords; j++) {
+        memcpy(&mChars[(size_t)j * mStride], sorted[j], wordLength);
+        for (uint k = 0; k < wordLength; k++)
+            mIsLetter[(uchr)sorted[j][k]] = true;
+    }
+    mNumLetters = 0;
+    for (uint uc = 0; uc < 256; uc++) {
+        mRank[uc] = mNumLetters;
+        if (mIsLetter[uc])
+            ++mNumLetters;
+    }
+
+    // Count the words under each pair of first letters, then add up the counts, so that
+    // mPairBeg[pair] is the number of words before it, and the last entry is all of them.
+    mPairBeg.clear();
+    if (wordLength < 2)
+        return;
+    mPairBeg.assign(mNumLetters * mNumLetters + 1, 0);
+    for (uint j = 0; j < mNumWords; j++) {
+        const uchr *word = (const uchr *)getWord(j);
+        mPairBeg[mRank[word[0]] * mNumLetters + mRank[word[1]] + 1]++;
+    }
+    for (size_t pair = 1; pair < mPairBeg.size(); pair++)
+        mPairBeg[pair] += mPairBeg[pair - 1];
+}
+
+uint WordArray::lowerBound(const char *key, uint keyLen) const
+{
+    if (keyLen == 0)
+        return 0;
+    uint beg = 0, end = mNumWords;
+    if (mWordLength < 2)
+        return bound(beg, end, key, 0, keyLen, false);
+    narrow(beg, end, 0, key[0]);
+    if (keyLen == 1 || beg == end)
+        return beg;
+    narrow(beg, end, 1, key[1]);
+    return keyLen == 2 || beg == end ? beg : bound(beg, end, key, 2, keyLen, false);
+}
+
+uint WordArray::upperBound(const char *key, uint keyLen) const
+{
+    if (keyLen == 0)
+        return mNumWords;
+    uint beg = 0, end = mNumWords;
+    if (mWordLength < 2)
+        return bound(beg, end, key, 0, keyLen, true);
+    narrow(beg, end, 0, key[0]);
+    if (keyLen == 1 || beg == end)
+        return end;
+    narrow(beg, end, 1, key[1]);
+    return keyLen == 2 || beg == end ? end : bound(beg, end, key, 2, keyLen, true);
+}
+
+void WordArray::narrow(uint& beg, uint& end, uint pos, uchr uc) const
+{
+    if (pos >= 2 || mWordLength < 2) {
+        beg = boundAt(beg, end, pos, uc, false);
+        if (beg < end && (uchr)getWord(beg)[pos] != uc)
+            end = beg;                      // most narrowing fails, so skip the upper bound then
+        else
+            end = boundAt(beg, end, pos, uc, true);
+        return;
+    }
+    // The run for one or two first letters is in the index.  The words given all have the
+    // same first pos letters, so the run found either holds them or is outside them.  If uc
+    // is in no word, the run is empty, but still starts where words with uc would be.
+    uint runBeg, runEnd, next = mIsLetter[uc] ? 1 : 0;
+    if (pos == 0) {
+        runBeg = pairBeg(mRank[uc], 0);
+        runEnd = pairBeg(mRank[uc] + next, 0);
+    } else {
+        uint rank0 = beg < end ? mRank[(uchr)getWord(beg)[0]] : 0;
+        runBeg = pairBeg(rank0, mRank[uc]);
+        runEnd = pairBeg(rank0, mRank[uc] + next);
+    }
+    beg = std::min(std::max(beg, runBeg), end);
+    end = std::max(beg, std::min(end, runEnd));
+}
+
+/**
+* Binary search with no branch on the compares: halve the run each time, keeping its lower
+* half unless the middle word is still before the bound, and step past the last word if it
+* is, too.  A word is before the lower bound if it compares less than key, and before the
+* upper bound if it compares less than or equal.
+*/
+uint WordArray::bound(uint beg, uint end, const char *key, uint from, uint keyLen, bool upper) const
+{
+    if (beg >= end)
+        return beg;
+    const char *base = getWord(beg) + from;
+    const char *pkey = key + from;
+    const size_t len = keyLen - from;
+    const int    lim = upper ? 1 : 0;
+    for (uint num = end - beg; num > 1; ) {
+        uint half = num / 2;
+        const char *mid = base + (size_t)half * mStride;
+        base = memcmp(mid, pkey, len) < lim ? mid : base;
+        num -= half;
+    }
+    uint idx = (uint)((base - from - &mChars[0]) / mStride);
+    return idx + (memcmp(base, pkey, len) < lim ? 1 : 0);
+}
+
+uint WordArray::boundAt(uint beg, uint end, uint pos, uchr uc, bool upper) const
+{
+    if (beg >= end)
+        return beg;
+    const uchr *base = (const uchr *)getWord(beg) + pos;
+    const uint  lim  = (uint)uc + (upper ? 1 : 0);
+    for (uint num = end - beg; num > 1; ) {
+        uint half = num / 2;
+        const uchr *mid = base + (size_t)half * mStride;
+        base = *mid < lim ? mid : base;
+        num -= half;
+    }
+    uint idx = (uint)((base - pos - (const uchr *)&mChars[0]) / mStride);
+    return idx + (*base < lim ? 1 : 0);
+}
@@ -0,0 +1,71 @@
+// WordArray.hpp : the words of one length, sorted, back to back in one array, with fast prefix bounds
+
+#ifndef WordArray_hpp
+#define WordArray_hpp
+
+#include <vector>
+
+#include "wordTypes.h"
+
+/**
+*   A sorted array of fixed-length words, for finding word rects without tries (option -m).
+*   It replaces a std::map<const char*, int> per length, whose nodes were spread over the heap
+*   and whose upper_bound took a string compare per level of a red-black tree.
+*
+*   The words are kept back to back in one block, each NULL-terminated so that getWord gives
+*   a C string, in order of their unsigned chars (as by memcmp, not by any CharMap).  So every
+*   set of words with a common prefix is one run of indices, and the bounds of such a run are
+*   found by binary search over just the chars after the prefix, with no branch on the result
+*   of each compare, only a conditional move.
+*
+*   The first two chars are not searched at all: an index of where each pair of first chars
+*   begins, over the chars that occur in the words, gives the run for any one- or two-char
+*   prefix in two reads.  That is where most of the searches in a word rect finder start.
+*/
+class WordArray
+{
+public:
+    WordArray() : mWordLength(0), mStride(1), mNumWords(0), mNumLetters(0) { }
+    WordArray(const WordArray&);                // Prevent pass-by-value by not defining this copy constructor.
+    WordArray& operator=(const WordArray&);     // Prevent assignment by not defining this operator.
+
+    /** Copy and sort words, which must all be wordLength chars long and different, and index them. */
+    void                assign(const std::vector<const char *>& words, uint wordLength);
+
+    inline uint         size()                  const { return mNumWords; }
+    inline uint         getWordLength()         const { return mWordLength; }
+    inline const char * getWord(uint idx)       const { return &mChars[idx * mStride]; }
+
+    /** Index of the first word whose first keyLen chars are not less than key's, or size() if none. */
+    uint                lowerBound(const char *key, uint keyLen) const;
+
+    /** Index of the first word whose first keyLen chars are greater than key's, or size() if none. */
+    uint                upperBound(const char *key, uint keyLen) const;
+
+    /**
+    * Narrow the run of words [beg, end), which must all have the same first pos chars, to the
+    * ones that also have uc at pos.  If there are none, beg == end afterwards.
+    */
+    void                narrow(uint& beg, uint& end, uint pos, uchr uc) const;
+
+private:
+    /** First index in [beg, end) whose chars [from, keyLen) are not less (or, if upper, greater) than key's. */
+    uint                bound(uint beg, uint end, const char *key, uint from, uint keyLen, bool upper) const;
+
+    /** Same, comparing only the char at pos with uc. */
+    uint                boundAt(uint beg, uint end, uint pos, uchr uc, bool upper) const;
+
+    /** Where the words starting with letters of rank r0 and r1 (or any higher pair) begin. */
+    inline uint         pairBeg(uint r0, uint r1) const { return mPairBeg[r0 * mNumLetters + r1]; }
+
+    uint                mWordLength;
+    uint                mStride;            // mWordLength + 1, for the NULLs
+    uint                mNumWords;
+    uint                mNumLetters;        // number of different chars in the words
+    std::vector<char>   mChars;             // the words, in order, each followed by a NULL
+    std::vector<uint>   mPairBeg;           // mNumLetters^2 + 1 run starts, by the ranks of the first two chars
+    uint                mRank[256];         // number of letters less than each char
+    bool                mIsLetter[256];     // whether each char is in any word
+};
+
+#endif // WordArray_hpp
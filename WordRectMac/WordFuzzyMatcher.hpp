@@ -0,0 +1,531 @@
+// WordFuzzyMatcher.hpp : find the dictionary words nearest to any word, by edit distance
+
+#ifndef WordFuzzyMatcher_hpp
+#define WordFuzzyMatcher_hpp
+
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#include "WordTrie.hpp"
+
+/**
+*   Spelling suggestions: the k words in one or more WordTries that are nearest to a given
+*   word, counting each char inserted, deleted, or changed as 1, and (by default) each swap
+*   of two adjacent chars as 1, too (Damerau's distance, in its restricted form).
+*
+*   For maxDist up to the index distance given when the matcher is made (2 by default), no
+*   trie is walked.  The matcher keeps a deletion-neighborhood index instead: every word is
+*   filed under the hash of itself and of each string made by deleting up to that many of its
+*   chars.  Two words within distance d of each other have a common string after at most d
+*   deletions from each (a change is a deletion from both at the same place, an insertion is
+*   a deletion from the other word, and a swap of ab and ba is deleting a from both), so the
+*   words filed under the query's own deletions are all the candidates there are.  Each one
+*   not seen yet for this query gets its exact distance from a bit-vector pass over its chars
+*   (see bitDistance), and the nearest k are sorted into the order the trie walk would find
+*   them in.  A word of length L is filed under up to 1 + L + L(L - 1) / 2 keys at distance 2,
+*   so the index takes several times the tries' memory, and some tenths of a second to build.
+*
+*   For larger maxDist, the search walks each trie depth first, keeping one row of the
+*   edit-distance table per depth: the row for a node is worked out from its parent's (and
+*   grandparent's, for swaps) as the node is entered, so words that share a stem share its
+*   rows.  Only the cells within maxDist of the diagonal are worked out, since no others can
+*   lead to a near enough word.  A node's subtree is skipped when no word in it can come
+*   within the bound, which starts at maxDist and tightens to just under the k-th best
+*   distance once there are k candidates.  In a fixed-length trie the bound also counts the
+*   chars still to come: at depth d, with j chars of the query matched, at least
+*   |(queryLength - j) - (wordLength - d)| more edits are needed.  Tries are searched nearest
+*   length first, so most of the bound's tightening is done before the far lengths are tried.
+*   Each node also knows which letters are below it, so before descending, the bound can also
+*   count the query chars after j that are not among them (see minMissingDist).
+*
+*   The trie nodes are spread over the heap, each next to its own branch array, so walking
+*   them would cost a cache miss or two per node.  Instead, the matcher copies each trie's
+*   shape once, when it is made, into one array of small nodes with every node's children
+*   side by side, and walks that.  So words added to the tries after that are not seen.
+*
+*   Either way, ties are broken by trie order, nearest length first, so both give the same
+*   answers.  The scratch space is kept from query to query, so a matcher allocates little
+*   once it has seen its longest query; it is not thread-safe, so make one per thread.
+*/
+template <typename MapT, typename NodeT>
+class WordFuzzyMatcher
+{
+public:
+    static const uint sDefaultMaxDist = 2;
+    static const uint sDefaultK       = 10;
+
+    struct Match
+    {
+        const char    * mWord;
+        uint            mDistance;
+    };
+
+    /**
+    * Match words in tries[minLength, maxLength], any of which may be NULL (as for lengths not loaded).
+    * Queries with maxDist up to indexDist use the deletion index; 0 builds none, and every query walks the tries.
+    */
+    WordFuzzyMatcher(const WordTrie<MapT, NodeT> * const tries[], uint minLength, uint maxLength, bool countSwaps = true
+        , uint indexDist = sDefaultMaxDist)
+        : mCountSwaps(countSwaps), mIndexDist(indexDist), mStamp(0)
+    {
+        for (uint length = minLength; length <= maxLength; length++) {
+            if (tries[length] != NULL)
+                addTrie(*tries[length]);
+        }
+        if (mIndexDist > 0)
+            buildIndex();
+    }
+
+    /** Match the words in just one trie, of fixed or variable word length. */
+    WordFuzzyMatcher(const WordTrie<MapT, NodeT>& trie, bool countSwaps = true, uint indexDist = sDefaultMaxDist)
+        : mCountSwaps(countSwaps), mIndexDist(indexDist), mStamp(0)
+    {
+        addTrie(trie);
+        if (mIndexDist > 0)
+            buildIndex();
+    }
+    WordFuzzyMatcher(const WordFuzzyMatcher&);              // Prevent pass-by-value by not defining this copy constructor.
+    WordFuzzyMatcher& operator=(const WordFuzzyMatcher&);   // Prevent assignment by not defining this operator.
+
+    /**
+    * Put the (up to k) words nearest to word and no farther than maxDist into nearest,
+    * nearest first, and return how many there are.  The word itself, if it is in a trie,
+    * is the first of them, at distance 0.
+    */
+    uint findNearest(const char *word, uint maxDist, uint k, Match nearest[])
+    {
+        if (k == 0)
+            return 0;
+        mQuery      = (const uchr *)word;
+        mQueryLen   = (uint)strlen(word);
+        mMaxDist    = maxDist;
+        mMaxK       = k;
+        mNearest    = nearest;
+        mNumNearest = 0;
+        if (mIndexDist > 0 && maxDist <= mIndexDist)
+            return findIndexed();
+
+        mMaxDepth   = mQueryLen + maxDist;     // no word longer than this is near enough
+        size_t rowsSize = (size_t)(mMaxDepth + 1) * (mQueryLen + 1);
+        if (mRows.size() < rowsSize)
+            mRows.resize(rowsSize);
+        std::fill(mRows.begin(), mRows.begin() + rowsSize, maxDist + 1);
+        for (uint j = 0; j <= mQueryLen; j++)
+            mRows[j] = j;
+        mQueryBits.resize(mQueryLen);
+        for (uint j = 0; j < mQueryLen; j++)
+            mQueryBits[j] = letterBit(mQuery[j]);
+
+        // Nearest length first: the lengths at distance 0, 1, 2, ... from the query's.
+        for (uint lengthDiff = 0; lengthDiff <= maxDist; lengthDiff++) {
+            for (size_t t = 0; t < mRoots.size(); t++) {
+                uint length = mWordLengths[t];
+                uint diff = length == 0 ? 0 : (length > mQueryLen ? length - mQueryLen : mQueryLen - length);
+                if (diff == lengthDiff && (int)diff <= bound())
+                    matchFrom(mNodes[mRoots[t]], 0, length);
+            }
+        }
+        return mNumNearest;
+    }
+
+    inline size_t   getNumNodes()   const { return mNodes.size(); }
+
+private:
+    struct FlatNode
+    {
+        uint            mFirstChild;    // index in mNodes of the first of this node's children, which are all side by side
+        uint            mNumChildren;
+        uchr            mLetter;
+        uint64          mBelow;         // letterBit of every letter in this node's subtree, not counting its own
+    };
+
+    static inline uint64 letterBit(uchr uc) { return (uint64)1 << (uc & 63); }
+
+    void addTrie(const WordTrie<MapT, NodeT>& trie)
+    {
+        mRoots.push_back((uint)mNodes.size());
+        mWordLengths.push_back((uint)trie.getWordLength());
+        mNodes.push_back(FlatNode());
+        mWords.push_back(NULL);
+        addChildren(trie.getRoot(), mRoots.back());
+    }
+
+    /** Copy node's children to the end of mNodes, then their children after them, and so on down. */
+    void addChildren(const NodeT *node, uint nodeIdx)
+    {
+        uint firstChild = (uint)mNodes.size(), numChildren = 0;
+        for (const NodeT *child = node->getFirstChild(); child != NULL; child = child->getNextBranch()) {
+            FlatNode flat;
+            flat.mFirstChild  = 0;
+            flat.mNumChildren = 0;
+            flat.mLetter      = child->getLetterAt(node->getDepth());
+            flat.mBelow       = 0;
+            mNodes.push_back(flat);
+            mWords.push_back(child->getWord());
+            ++numChildren;
+        }
+        mNodes[nodeIdx].mFirstChild  = firstChild;
+        mNodes[nodeIdx].mNumChildren = numChildren;
+        const NodeT *child = node->getFirstChild();
+        uint64 below = 0;
+        for (uint j = 0; j < numChildren; j++, child = child->getNextBranch()) {
+            addChildren(child, firstChild + j);
+            below |= mNodes[firstChild + j].mBelow | letterBit(mNodes[firstChild + j].mLetter);
+        }
+        mNodes[nodeIdx].mBelow = below;
+    }
+
+    static const uint           sMinSlots = 1 << 12;    // must be a power of 2
+    static const uint           sMaxBitsLen = 64;       // bits in the masks of bitDistance
+
+    /** Words must come within this distance to be kept: maxDist, or less than the k-th best so far. */
+    inline int bound() const { return mNumNearest < mMaxK ? (int)mMaxDist : (int)mNearest[mMaxK - 1].mDistance - 1; }
+
+    void matchFrom(const FlatNode& node, uint depth, uint wordLength)
+    {
+        const uint   width  = mQueryLen + 1;
+        const uint * prev   = &mRows[depth * width];
+        const uint * prev2  = depth > 0 ? prev - width : NULL;
+        uint       * row    = &mRows[(depth + 1) * width];
+        const uchr   prevUc = node.mLetter;
+        const bool   swaps  = mCountSwaps && prev2 != NULL;
+
+        // Only the cells within mMaxDist of the diagonal can be near enough; the others stay at mMaxDist + 1.
+        const uint   begJ   = depth + 1 > mMaxDist ? depth + 1 - mMaxDist : 1;
+        const uint   endJ   = depth + 1 + mMaxDist < mQueryLen ? depth + 1 + mMaxDist : mQueryLen;
+        // A fixed-length word has restLen chars after this one, and must take at least |(mQueryLen - j) - restLen|
+        // more edits to get from row[j] to the end.  In a variable-length trie, any row[j] might be the last.
+        const int    restLen = wordLength > 0 ? (int)wordLength - (int)depth - 1 : -1;
+
+        for (uint childIdx = node.mFirstChild, endIdx = childIdx + node.mNumChildren; childIdx < endIdx; childIdx++) {
+            const FlatNode& child = mNodes[childIdx];
+            const uchr uc = child.mLetter;
+            uint minDist = row[0] = depth + 1;
+            if (restLen >= 0)
+                minDist += abs((int)mQueryLen - restLen);
+            for (uint j = begJ; j <= endJ; j++) {
+                uint dist = std::min(prev[j - 1] + (mQuery[j - 1] != uc), std::min(prev[j], row[j - 1]) + 1);
+                if (swaps && j > 1 && mQuery[j - 1] == prevUc && mQuery[j - 2] == uc)
+                    dist = std::min(dist, prev2[j - 2] + 1);
+                row[j] = dist;
+                if (restLen >= 0)
+                    dist += abs((int)(mQueryLen - j) - restLen);
+                minDist = std::min(minDist, dist);
+            }
+            int maxDist = bound();
+            if ((int)minDist > maxDist)
+                continue;
+            if (mWords[childIdx] != NULL && (int)row[mQueryLen] <= maxDist) {
+                addNearest(mWords[childIdx], row[mQueryLen]);
+                maxDist = bound();
+            }
+            if (depth + 1 < mMaxDepth && child.mNumChildren > 0 && (int)minDist <= maxDist
+                && (int)minMissingDist(child, row, begJ, endJ, restLen) <= maxDist)
+                matchFrom(child, depth + 1, wordLength);
+        }
+    }
+
+    /**
+    * Tighten the bound on the words below child, whose row was just worked out: each query char
+    * from j on that is not among the letters below child (or child's own, which a swap can still
+    * use) costs at least one more edit, so row[j] needs at least that many more.  Only worth the
+    * pass over the query for children that get past the cheaper bound.
+    */
+    uint minMissingDist(const FlatNode& child, const uint *row, uint begJ, uint endJ, int restLen)
+    {
+        const uint64 letters = child.mBelow | (mCountSwaps ? letterBit(child.mLetter) : 0);
+        uint missing = 0, minDist = mMaxDist + 1;
+        for (uint j = mQueryLen; j >= begJ; j--) {
+            if (j <= endJ) {
+                int need = restLen >= 0 ? abs((int)(mQueryLen - j) - restLen) : 0;
+                minDist = std::min(minDist, row[j] + (uint)std::max(need, (int)missing));
+            }
+            missing += (letters & mQueryBits[j - 1]) == 0;
+        }
+        // Of the cells before begJ, only row[0] is inside the band; missing now counts from begJ - 1 on.
+        int need = restLen >= 0 ? abs((int)mQueryLen - restLen) : 0;
+        return std::min(minDist, row[0] + (uint)std::max(need, (int)missing));
+    }
+
+    /** A word in the deletion index.  Ids are in search order: trie by trie, each depth first, as matchFrom finds them. */
+    struct IndexWord
+    {
+        const uchr    * mWord;
+        uint            mLength;
+        uint            mTrieLength;    // word length of its trie, or 0 if not fixed, for the nearest-length-first order
+    };
+
+    /** A candidate within maxDist, in the order the trie walk would have found it. */
+    struct Candidate
+    {
+        uint            mDistance;
+        uint            mLengthDiff;
+        uint            mId;
+
+        inline bool operator<(const Candidate& other) const
+        {
+            if (mDistance != other.mDistance)
+                return mDistance < other.mDistance;
+            if (mLengthDiff != other.mLengthDiff)
+                return mLengthDiff < other.mLengthDiff;
+            return mId < other.mId;
+        }
+    };
+
+    void addIndexWords(uint nodeIdx, uint trieLength)
+    {
+        const FlatNode& node = mNodes[nodeIdx];
+        for (uint childIdx = node.mFirstChild, endIdx = childIdx + node.mNumChildren; childIdx < endIdx; childIdx++) {
+            if (mWords[childIdx] != NULL) {
+                IndexWord word = { (const uchr *)mWords[childIdx], (uint)strlen(mWords[childIdx]), trieLength };
+                mIndexWords.push_back(word);
+            }
+            addIndexWords(childIdx, trieLength);
+        }
+    }
+
+    /** File every word under its own hash and the hashes of all its deletions of up to mIndexDist chars. */
+    void buildIndex()
+    {
+        for (size_t t = 0; t < mRoots.size(); t++)
+            addIndexWords(mRoots[t], mWordLengths[t]);
+
+        std::vector< std::pair<uint64, uint> > filed;
+        std::vector<uint64> hashes;
+        for (uint id = 0; id < (uint)mIndexWords.size(); id++) {
+            const IndexWord& word = mIndexWords[id];
+            hashes.clear();
+            addAllDeletions(word.mWord, word.mLength, mIndexDist, hashes);
+            std::sort(hashes.begin(), hashes.end());
+            hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+            for (size_t j = 0; j < hashes.size(); j++)
+                filed.push_back(std::make_pair(hashes[j], id));
+        }
+        std::sort(filed.begin(), filed.end());
+
+        size_t numKeys = 0;
+        for (size_t j = 0; j < filed.size(); j++)
+            numKeys += j == 0 || filed[j].first != filed[j - 1].first;
+        uint numSlots = sMinSlots;
+        while (numSlots < 2 * numKeys)
+            numSlots *= 2;
+        mSlots.assign(numSlots, 0);
+        uint mask = numSlots - 1;
+
+        // Each key's postings are its count of ids, then the ids, in search order.
+        mPostings.reserve(filed.size() + numKeys);
+        for (size_t j = 0, endJ; j < filed.size(); j = endJ) {
+            const uint64 hash = filed[j].first;
+            for (endJ = j + 1; endJ < filed.size() && filed[endJ].first == hash; endJ++)
+                ;
+            uint slot = (uint)hash & mask;
+            while (mSlots[slot] != 0)
+                slot = (slot + 1) & mask;
+            mSlots[slot] = (hash >> 32) << 32 | (uint64)(mPostings.size() + 1);
+            mPostings.push_back((uint)(endJ - j));
+            for (size_t k = j; k < endJ; k++)
+                mPostings.push_back(filed[k].second);
+        }
+        mSeen.assign(mIndexWords.size(), 0);
+    }
+
+    /** Add the hash of chars[0, length), and of each string made from it by deleting up to deletions chars, to hashes. */
+    void addAllDeletions(const uchr *chars, uint length, uint deletions, std::vector<uint64>& hashes)
+    {
+        size_t scratchSize = (size_t)deletions * length;
+        if (mScratch.size() < scratchSize)
+            mScratch.resize(scratchSize);
+        addDeletions(chars, length, 0, deletions, length, hashes);
+    }
+
+    /**
+    * Deleting in increasing order of position makes each set of positions once; strings that repeat
+    * anyway (as from deleting either s of "ss") are not weeded out.  Each level of the recursion has
+    * its own stride of mScratch for the chars left after its deletion.
+    */
+    void addDeletions(const uchr *chars, uint length, uint from, uint deletions, uint stride, std::vector<uint64>& hashes)
+    {
+        hashes.push_back(hashChars(chars, length));
+        if (deletions == 0 || length == 0)
+            return;
+        uchr *less = &mScratch[(size_t)(deletions - 1) * stride];
+        for (uint j = from; j < length; j++) {
+            memcpy(less, chars, j);
+            memcpy(less + j, chars + j + 1, length - j - 1);
+            addDeletions(less, length - 1, j, deletions - 1, stride, hashes);
+        }
+    }
+
+    /** FNV-1a, as in TextWordCounts: it only needs to spread the keys over the slots. */
+    static inline uint64 hashChars(const uchr *chars, uint length)
+    {
+        uint64 hash = 14695981039346656037ULL;
+        for (uint j = 0; j < length; j++) {
+            hash ^= chars[j];
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    /** Check each word filed in the postings at offset that this query has not checked yet, and keep it if near enough. */
+    void checkPostings(uint offset)
+    {
+        for (uint p = offset + 1, endP = p + mPostings[offset]; p < endP; p++) {
+            uint id = mPostings[p];
+            if (mSeen[id] == mStamp)
+                continue;
+            mSeen[id] = mStamp;
+            const IndexWord& word = mIndexWords[id];
+            uint lengthDiff = word.mLength > mQueryLen ? word.mLength - mQueryLen : mQueryLen - word.mLength;
+            if (lengthDiff > mMaxDist)
+                continue;
+            uint distance = mQueryLen <= sMaxBitsLen ? bitDistance(word.mWord, word.mLength) : editDistance(word.mWord, word.mLength);
+            if (distance <= mMaxDist) {
+                Candidate cand = { distance, word.mTrieLength == 0 ? 0 : lengthDiff, id };
+                mCandidates.push_back(cand);
+            }
+        }
+    }
+
+    /** findNearest by the deletion index: every word filed under one of the query's deletions is a candidate. */
+    uint findIndexed()
+    {
+        if (++mStamp == 0) {
+            std::fill(mSeen.begin(), mSeen.end(), 0);
+            mStamp = 1;
+        }
+        mQueryHashes.clear();
+        addAllDeletions(mQuery, mQueryLen, mMaxDist, mQueryHashes);
+        if (mQueryLen <= sMaxBitsLen) {
+            memset(mQueryEq, 0, sizeof(mQueryEq));
+            for (uint j = 0; j < mQueryLen; j++)
+                mQueryEq[mQuery[j]] |= (uint64)1 << j;
+        } else {
+            mRows.resize((size_t)3 * (mQueryLen + 1));
+        }
+        mCandidates.clear();
+        const uint mask = (uint)mSlots.size() - 1;
+        for (size_t h = 0; h < mQueryHashes.size(); h++) {
+            // A slot whose tag matches is nearly always this key, but may be another with the same high bits.
+            // Checking the words of both is harmless, and stopping at the first could miss this key's.
+            const uint64 hash = mQueryHashes[h];
+            for (uint slot = (uint)hash & mask; mSlots[slot] != 0; slot = (slot + 1) & mask) {
+                if (mSlots[slot] >> 32 == hash >> 32)
+                    checkPostings((uint)mSlots[slot] - 1);
+            }
+        }
+        mNumNearest = std::min(mMaxK, (uint)mCandidates.size());
+        std::partial_sort(mCandidates.begin(), mCandidates.begin() + mNumNearest, mCandidates.end());
+        for (uint j = 0; j < mNumNearest; j++) {
+            mNearest[j].mWord     = (const char *)mIndexWords[mCandidates[j].mId].mWord;
+            mNearest[j].mDistance = mCandidates[j].mDistance;
+        }
+        return mNumNearest;
+    }
+
+    /**
+    * The distance from the query to word, worked out a whole column of the table at a time: Hyyro's
+    * bit-vector algorithm (2003), which keeps each column as bit masks of its +1 and -1 steps, with
+    * his term for swaps.  It gives the same distances as matchFrom, in a few dozen word operations
+    * per char of word, and is for queries of up to sMaxBitsLen chars.
+    */
+    uint bitDistance(const uchr *word, uint wordLength) const
+    {
+        if (mQueryLen == 0)
+            return wordLength;
+        const uint64 last = (uint64)1 << (mQueryLen - 1);
+        uint64 vp = ~(uint64)0, vn = 0, d0 = 0, prevEq = 0;
+        uint dist = mQueryLen;
+        for (uint i = 0; i < wordLength; i++) {
+            const uint64 eq = mQueryEq[word[i]];
+            const uint64 tr = mCountSwaps ? ((~d0 & eq) << 1) & prevEq : 0;
+            d0 = (((eq & vp) + vp) ^ vp) | eq | vn | tr;
+            uint64 hp = vn | ~(d0 | vp);
+            uint64 hn = d0 & vp;
+            dist += (hp & last) != 0;
+            dist -= (hn & last) != 0;
+            hp = (hp << 1) | 1;
+            hn = hn << 1;
+            vp = hn | ~(d0 | hp);
+            vn = hp & d0;
+            prevEq = eq;
+        }
+        return dist;
+    }
+
+    /**
+    * The distance from the query to word, for queries too long for bitDistance: by the same recurrence
+    * as matchFrom, one row per char of word and only the cells within mMaxDist of the diagonal; or
+    * mMaxDist + 1 as soon as none of those in a row is within mMaxDist.  The cells just outside the
+    * band are set to mMaxDist + 1, since the rows are reused.
+    */
+    uint editDistance(const uchr *word, uint wordLength)
+    {
+        const uint width = mQueryLen + 1;
+        uint *prev2 = &mRows[0], *prev = prev2 + width, *row = prev + width;
+        for (uint j = 0; j <= mQueryLen; j++)
+            prev[j] = std::min(j, mMaxDist + 1);
+        for (uint i = 1; i <= wordLength; i++) {
+            const uchr uc = word[i - 1];
+            const uint begJ = i > mMaxDist ? i - mMaxDist : 1;
+            const uint endJ = i + mMaxDist < mQueryLen ? i + mMaxDist : mQueryLen;
+            uint minDist = row[begJ - 1] = begJ == 1 ? std::min(i, mMaxDist + 1) : mMaxDist + 1;
+            if (endJ < mQueryLen)
+                row[endJ + 1] = mMaxDist + 1;
+            for (uint j = begJ; j <= endJ; j++) {
+                uint dist = std::min(prev[j - 1] + (mQuery[j - 1] != uc), std::min(prev[j], row[j - 1]) + 1);
+                if (mCountSwaps && i > 1 && j > 1 && mQuery[j - 1] == word[i - 2] && mQuery[j - 2] == uc)
+                    dist = std::min(dist, prev2[j - 2] + 1);
+                row[j] = dist;
+                minDist = std::min(minDist, dist);
+            }
+            if (minDist > mMaxDist)
+                return mMaxDist + 1;
+            uint *oldest = prev2;
+            prev2 = prev;
+            prev  = row;
+            row   = oldest;
+        }
+        return prev[mQueryLen];
+    }
+
+    /** Insert word into mNearest after any as near as it, dropping the farthest if there are more than mMaxK. */
+    void addNearest(const char *word, uint distance)
+    {
+        uint j = mNumNearest < mMaxK ? mNumNearest++ : mMaxK - 1;
+        for ( ; j > 0 && mNearest[j - 1].mDistance > distance; j--)
+            mNearest[j] = mNearest[j - 1];
+        mNearest[j].mWord     = word;
+        mNearest[j].mDistance = distance;
+    }
+
+    std::vector<FlatNode>       mNodes;         // the nodes of all the tries, each trie's root first
+    std::vector<const char *>   mWords;         // the word of each node in mNodes, or NULL if it is not a word node
+    std::vector<uint>           mRoots;         // index in mNodes of each trie's root
+    std::vector<uint>           mWordLengths;   // word length of each trie, or 0 if not fixed
+    const bool                  mCountSwaps;
+    std::vector<uint>           mRows;          // one edit-distance row per depth (or 3 rows for editDistance), each mQueryLen + 1 long
+    std::vector<uint64>         mQueryBits;     // letterBit of each query char
+    const uint                  mIndexDist;     // queries with maxDist up to this use the deletion index
+    std::vector<IndexWord>      mIndexWords;
+    std::vector<uint>           mPostings;      // for each key, its count of ids and then the ids
+    std::vector<uint64>         mSlots;         // open addressing with linear probing: each slot holds the key's high 32 bits,
+                                                // then the offset of its postings plus one, so one look at a slot finds them
+    std::vector<uint>           mSeen;          // per word id, the stamp of the last query that checked it
+    uint                        mStamp;
+    std::vector<uint64>         mQueryHashes;
+    std::vector<Candidate>      mCandidates;
+    uint64                      mQueryEq[256];  // for bitDistance: the bits of the query's positions that hold each char
+    std::vector<uchr>           mScratch;       // one deletion buffer per level of addDeletions
+    const uchr                * mQuery;
+    uint                        mQueryLen;
+    uint                        mMaxDist;
+    uint                        mMaxK;
+    uint                        mMaxDepth;
+    Match                     * mNearest;
+    uint                        mNumNearest;
+};
+
+#endif // WordFuzzyMatcher_hpp
@@ -0,0 +1,131 @@
+// WordGrid.cpp : a crossword-style grid of open and blocked cells, and the word slots through it
+
+#include <stdio.h>
+#include <string.h>
+
+#include "WordGrid.hpp"
+
+bool WordGrid::makeMask(const char *name, int wide, int tall, std::vector<std::string>& rows)
+{
+    char oddCell;
+    if (strcmp(name, "rect") == 0)
+        oddCell = sOpen;
+    else if (strcmp(name, "lattice") == 0)
+        oddCell = sBlocked;
+    else if (strcmp(name, "waffle") == 0)
+        oddCell = sBridged;
+    else
+        return false;
+
+    rows.assign(tall, std::string(wide, sOpen));
+    for (int row = 1; row < tall; row += 2) {
+        for (int col = 1; col < wide; col += 2)
+            rows[row][col] = oddCell;
+    }
+    return true;
+}
+
+int WordGrid::readMask(const char *fileName, std::vector<std::string>& rows)
+{
+    FILE *fp = fopen(fileName, "r");
+    if (fp == NULL)
+        return -1;
+    rows.clear();
+    char line[1024];
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        size_t len = strcspn(line, " \t\r\n");
+        if (len > 0)
+            rows.push_back(std::string(line, len));
+    }
+    bool failed = ferror(fp) != 0;
+    fclose(fp);
+    return failed ? -1 : (int)rows.size();
+}
+
+int WordGrid::init(const std::vector<std::string>& mask, uint maxWordLength)
+{
+    mTall = (int)mask.size();
+    mWide = mTall > 0 ? (int)mask[0].size() : 0;
+    if (mWide < 2 || mTall < 2) {
+        printf("WordGrid: a grid must be at least 2 cells wide and tall, not %d * %d.\n", mWide, mTall);
+        return -1;
+    }
+    mMask.clear();
+    for (int row = 0; row < mTall; row++) {
+        if ((int)mask[row].size() != mWide) {
+            printf("WordGrid: row %d is %d cells wide, not %d like row 0.\n", row, (int)mask[row].size(), mWide);
+            return -1;
+        }
+        mMask += mask[row];
+    }
+    for (uint cell = 0; cell < getNumCells(); cell++) {
+        char ch = mMask[cell];
+        if (ch != sOpen && ch != sBlocked && ch != sBridged) {
+            printf("WordGrid: cell %d of row %d is '%c', not one of '%c' (open), '%c' (blocked), or '%c' (bridged).\n"
+                , cell % mWide, cell / mWide, ch, sOpen, sBlocked, sBridged);
+            return -1;
+        }
+    }
+
+    mSlots.clear();
+    mSlotCells.clear();
+    mAcross.assign(getNumCells(), -1);
+    mDown.assign(getNumCells(), -1);
+    mDownPos.assign(getNumCells(), 0);
+    int error = 0;
+    for (int row = 0; row < mTall; row++)
+        addSlots(false, row, maxWordLength, error);
+    for (int col = 0; col < mWide; col++)
+        addSlots(true, col, maxWordLength, error);
+    for (uint cell = 0; cell < getNumCells(); cell++) {
+        if (isOpen(cell) && mAcross[cell] < 0 && mDown[cell] < 0) {
+            printf("WordGrid: cell %d of row %d is open, but in no word of 2 or more letters.\n", cell % mWide, cell / mWide);
+            ++error;
+        }
+    }
+    return error > 0 ? -1 : (int)mSlots.size();
+}
+
+/** Add the slots of one row (or column, if down), with their cells, breaking at blocked cells and skipping bridged ones. */
+void WordGrid::addSlots(bool down, int line, uint maxWordLength, int& error)
+{
+    const int length = down ? mTall : mWide;
+    std::vector<uint> run;
+    for (int pos = 0; pos <= length; pos++) {
+        uint cell = down ? pos * mWide + line : line * mWide + pos;
+        if (pos < length && mMask[cell] == sOpen) {
+            run.push_back(cell);
+            continue;
+        }
+        if (pos < length && mMask[cell] == sBridged)
+            continue;
+        if (run.size() >= 2) {
+            if (run.size() > maxWordLength) {
+                printf("WordGrid: the %s word at cell %d of row %d is %d letters long, but the longest words loaded are %d.\n"
+                    , down ? "down" : "across", run[0] % mWide, run[0] / mWide, (int)run.size(), maxWordLength);
+                ++error;
+            }
+            Slot slot;
+            slot.mDown      = down;
+            slot.mLength    = (uint)run.size();
+            slot.mFirstCell = (uint)mSlotCells.size();
+            for (uint j = 0; j < run.size(); j++) {
+                mSlotCells.push_back(run[j]);
+                if (down) {
+                    mDown[run[j]]    = (int)mSlots.size();
+                    mDownPos[run[j]] = j;
+                } else {
+                    mAcross[run[j]]  = (int)mSlots.size();
+                }
+            }
+            mSlots.push_back(slot);
+        }
+        run.clear();
+    }
+}
+
+void WordGrid::printMask() const
+{
+    for (int row = 0; row < mTall; row++)
+        printf("    %s\n", mMask.substr(row * mWide, mWide).c_str());
+}
@@ -0,0 +1,96 @@
+// WordGrid.hpp : a crossword-style grid of open and blocked cells, and the word slots through it
+
+#ifndef WordGrid_hpp
+#define WordGrid_hpp
+
+#include <string>
+#include <vector>
+
+#include "wordTypes.h"
+
+/**
+*   The shape of a word grid to fill, as a mask of text rows, one char per cell:
+*
+*       .   an open cell, to hold a letter
+*       #   a blocked cell, which ends the words on either side of it
+*       +   a bridged cell, blocked, but read through: the letters on either side of it
+*           are in the same word, across and down
+*
+*   A slot is a run of 2 or more open cells across or down, not broken by a blocked cell or
+*   the edge.  Every open cell must be in a slot, and is in at most one slot each way.  So a
+*   word rect is a mask of all open cells, a word lattice is one with its odd rows' odd cells
+*   blocked, and a word waffle is the same with them bridged, which makes the minor rows and
+*   columns words, too:
+*
+*       rect        lattice     waffle      crossword
+*       .....       .....       .....       ...#....
+*       .....       .#.#.       .+.+.       ...#....
+*       .....       .....       .....       ........
+*                                           ....#...
+*
+*   The grid lists each slot's cells in reading order, and, for each cell, the slots it is in
+*   and where in them.  WordGridFinder fills the slots from the per-length tries.
+*/
+class WordGrid
+{
+public:
+    static const char sOpen    = '.';
+    static const char sBlocked = '#';
+    static const char sBridged = '+';
+
+    struct Slot
+    {
+        bool            mDown;          // false for across, true for down
+        uint            mLength;
+        uint            mFirstCell;     // index in mSlotCells of this slot's first cell
+    };
+
+    WordGrid() : mWide(0), mTall(0) { }
+    WordGrid(const WordGrid&);              // Prevent pass-by-value by not defining this copy constructor.
+    WordGrid& operator=(const WordGrid&);   // Prevent assignment by not defining this operator.
+
+    /** Make the mask of a rect, lattice, or waffle of this shape, by name.  Returns false for any other name. */
+    static bool         makeMask(const char *name, int wide, int tall, std::vector<std::string>& rows);
+
+    /** Read a mask from a text file, one row per line, skipping blank lines.  Returns the number of rows, or -1. */
+    static int          readMask(const char *fileName, std::vector<std::string>& rows);
+
+    /**
+    * Find the slots of mask, none of which may be longer than maxWordLength.  Returns the
+    * number of slots, or -1, after printing why, if mask is not a grid that can be filled.
+    */
+    int                 init(const std::vector<std::string>& mask, uint maxWordLength);
+
+    inline int          getWide()                   const { return mWide; }
+    inline int          getTall()                   const { return mTall; }
+    inline uint         getNumCells()               const { return (uint)mWide * mTall; }
+    inline bool         isOpen(uint cell)           const { return mMask[cell] == sOpen; }
+    inline uint         getNumSlots()               const { return (uint)mSlots.size(); }
+    inline const Slot & getSlot(uint slot)          const { return mSlots[slot]; }
+
+    /** The cells of a slot, in reading order, as indices row * wide + col. */
+    inline const uint * getSlotCells(uint slot)     const { return &mSlotCells[mSlots[slot].mFirstCell]; }
+
+    /** The across or down slot of a cell, or -1 if it is in none that way. */
+    inline int          getAcrossSlot(uint cell)    const { return mAcross[cell]; }
+    inline int          getDownSlot(uint cell)      const { return mDown[cell]; }
+
+    /** Where a cell is in its down slot, if it has one. */
+    inline uint         getDownPos(uint cell)       const { return mDownPos[cell]; }
+
+    void                printMask()                 const;
+
+private:
+    void                addSlots(bool down, int line, uint maxWordLength, int& error);
+
+    int                 mWide;
+    int                 mTall;
+    std::string         mMask;          // all the rows, back to back
+    std::vector<Slot>   mSlots;         // across slots first, in reading order, then down slots
+    std::vector<uint>   mSlotCells;     // each slot's cells, slot after slot
+    std::vector<int>    mAcross;        // per cell
+    std::vector<int>    mDown;          // per cell
+    std::vector<uint>   mDownPos;       // per cell
+};
+
+#endif // WordGrid_hpp
@@ -0,0 +1,202 @@
+// WordGridFinder.cpp : fill any grid of open and blocked cells with words, as in a crossword
+
+#include <string.h>
+#include <algorithm>
+
+#include "WordGridFinder.hpp"
+#include "WordRectPrinter.hpp"
+#include "WordRectSearchMgr.hpp"
+
+template <typename MapT>
+void WordGridFinder<MapT>::initRowsAndCols()
+{
+    if (this->mRowWordsNow != NULL)
+        return;
+    WordRectFinder<MapT>::initRowsAndCols();
+
+    const WordGrid& grid = *mGrid;
+    const uint numCells = grid.getNumCells(), numSlots = grid.getNumSlots();
+    const int  stride = this->mWantWide + 1;
+
+    // The grid text: a row of letters and blanks, and a NULL, for each row.
+    mGridNow.assign(this->mWantTall * stride, ' ');
+    mTextPos.resize(numCells);
+    for (int row = 0; row < this->mWantTall; row++) {
+        mGridNow[row * stride + this->mWantWide] = '\0';
+        for (int col = 0; col < this->mWantWide; col++)
+            mTextPos[row * this->mWantWide + col] = row * stride + col;
+    }
+    mGridOld  = mGridNow;
+    mGridDeep = mGridNow;
+    for (int row = 0; row < this->mWantTall; row++) {
+        this->mRowWordsNow[row]  = &mGridNow[row * stride];
+        this->mRowWordsOld[row]  = &mGridOld[row * stride];
+        this->mRowWordsDeep[row] = &mGridDeep[row * stride];
+    }
+
+    mSlotRoots.resize(numSlots);
+    mAcrossBase.assign(numSlots, 0);
+    for (uint slot = 0; slot < numSlots; slot++) {
+        const WordGrid::Slot& info = grid.getSlot(slot);
+        mSlotRoots[slot] = mTries[info.mLength]->getRoot();
+        if ( ! info.mDown) {
+            mAcrossNodes.push_back(mSlotRoots[slot]);
+            mAcrossBase[slot] = (uint)mAcrossNodes.size();
+            mAcrossNodes.resize(mAcrossNodes.size() + info.mLength, NULL);
+        }
+    }
+
+    // Each cell in a down slot branches from the down node of the cell above it in the slot,
+    // or from the slot's root, if it is the first.
+    mDownNodes.assign(numCells, NULL);
+    mDownParent.assign(numCells, NULL);
+    for (uint slot = 0; slot < numSlots; slot++) {
+        const WordGrid::Slot& info = grid.getSlot(slot);
+        if (info.mDown) {
+            const uint *cells = grid.getSlotCells(slot);
+            mDownParent[cells[0]] = &mSlotRoots[slot];
+            for (uint pos = 1; pos < info.mLength; pos++)
+                mDownParent[cells[pos]] = &mDownNodes[cells[pos - 1]];
+        }
+    }
+
+    // The steps, in reading order of their first cells.
+    for (uint cell = 0; cell < numCells; cell++) {
+        if ( ! grid.isOpen(cell))
+            continue;
+        GridStep step;
+        step.mSlot = grid.getAcrossSlot(cell);
+        step.mCell = cell;
+        step.mRow  = cell / this->mWantWide;
+        if (step.mSlot < 0 || grid.getSlotCells(step.mSlot)[0] == cell)
+            mSteps.push_back(step);
+    }
+}
+
+template <typename MapT>
+int WordGridFinder<MapT>::findWordRows()
+{
+    return findGridSteps(0);
+}
+
+template <typename MapT>
+int WordGridFinder<MapT>::findGridSteps(uint stepIdx)
+{
+    const bool done = stepIdx == mSteps.size();
+    const int haveTall = done ? this->mWantTall : mSteps[stepIdx].mRow;    // rows filled so far
+    this->mNowTall = haveTall;
+    if (haveTall > 1 && this->mWantArea <= WordRectSearchMgr<MapT>::getTrumpingArea()) {
+        this->mState = WordRectFinder<MapT>::eAborted;
+        return -this->mWantArea;    // Abort because a grid bigger than wantArea has been found
+    }
+    if (this->isPastDeadline()) {
+        this->mState = WordRectFinder<MapT>::eTimedOut;
+        return -this->mWantArea;    // Abort because this finder's time is up
+    }
+    if (done) {
+        return recordFoundGrid();   // Success: every slot has a word.
+    }
+    if (this->mMaxTall < haveTall) {
+        this->mMaxTall = haveTall;  // A new depth record: save the rows filled, as recordDeeperRows does.
+        memcpy(&mGridDeep[0], &mGridNow[0], haveTall * (this->mWantWide + 1));
+    }
+    const GridStep& step = mSteps[stepIdx];
+
+    if (step.mSlot < 0) {
+        // A lone cell: try each letter that can come next in its down slot.
+        const RectNode *parent = downParent(step.mCell);
+        const uint pos = parent->getDepth();
+        for (const RectNode *child = parent->getFirstChild(); child != NULL; child = child->getNextBranch()) {
+            mDownNodes[step.mCell] = child;
+            mGridNow[mTextPos[step.mCell]] = child->getLetterAt(pos);
+            int area = findGridSteps(stepIdx + 1);
+            if (area < 0 || (area > 0 && this->getNumFound() == this->getNumToFind()))
+                return area;
+        }
+        return 0;
+    }
+
+    // An across slot: try its words as WordRectFinder::findWordRowsUsingTrieLinks tries rows.
+    const WordTrie<MapT, RectNode>& trie = *mTries[mGrid->getSlot(step.mSlot).mLength];
+    const uint *cells = mGrid->getSlotCells(step.mSlot);
+    const int   lastK = (int)mGrid->getSlot(step.mSlot).mLength - 1;
+    const RectNode **nodes = &mAcrossNodes[mAcrossBase[step.mSlot]];   // nodes[-1] is the root
+
+    // Start from the first word whose first letter could come next in the first cell's down slot.
+    const RectNode *wordNode = NULL;
+    if (mDownParent[cells[0]] != NULL && mGrid->getDownPos(cells[0]) > 0) {
+        const RectNode *parent = downParent(cells[0]);
+        wordNode = trie.getFirstWordNodeFromIndex(trie.charIndex(parent->getLetterAt(parent->getDepth())));
+    } else {
+        wordNode = trie.getFirstWordNode();
+    }
+
+    for (int k = 0; wordNode != NULL; ) {
+        const char *word = wordNode->getStem();
+        for (;;) {
+            uchr letter = word[k];
+            uint index  = trie.charIndex(letter);
+            uint cell   = cells[k];
+            nodes[k] = nodes[k-1]->getBranchAtIndex(index);
+            if (mDownParent[cell] != NULL) {
+                const RectNode *downBranch = downParent(cell)->getBranchAtIndex(index);
+                if (downBranch == NULL)
+                    break;                      // No down word goes through this letter, so get the next word.
+                mDownNodes[cell] = downBranch;
+            }
+            mGridNow[mTextPos[cell]] = letter;
+            if (k == lastK) {
+                int area = findGridSteps(stepIdx + 1);
+                if (area < 0 || (area > 0 && this->getNumFound() == this->getNumToFind()))
+                    return area;
+                break;                          // This word failed deeper down, so get the next word.
+            }
+            k++;
+        }
+        // This word failed at letter k, so skip to the first word with a greater k-letter stem.
+        const RectNode *nextStem = nodes[k]->getNextStemNode();
+        if (nextStem == NULL)
+            return 0;
+        k = nextStem->getDepth() - 1;
+        wordNode = nextStem->getFirstWordNode();
+    }
+    return 0;   // Failure: no grid at the end of this path
+}
+
+/**
+* Success: every slot has a word.  Keep the grid (or in counting mode, just count it) and
+* return its area, as WordRectFinder::recordFoundRect does.
+*/
+template <typename MapT>
+int WordGridFinder<MapT>::recordFoundGrid()
+{
+    this->mMaxTall = this->mWantTall;
+    if (this->mCountOnly) {
+        ++this->mNumCounted;
+        if (isSymmetricSquare())
+            ++this->mNumSymCounted;
+        return 0;
+    }
+    std::copy(mGridNow.begin(), mGridNow.end(), mGridOld.begin());
+    this->mIsLastRectSymSquare = isSymmetricSquare();
+    if (this->mIsLastRectSymSquare)
+        ++this->mNumSymSquares;
+    if (this->incNumFound() != this->getNumToFind() && WordRectSearchMgr<MapT>::getVerbosity() > 1) {
+        WordRectPrinter::printRect(this);
+    }
+    return this->mWantArea;
+}
+
+template <typename MapT>
+bool WordGridFinder<MapT>::isSymmetricSquare() const
+{
+    if (this->mWantTall != this->mWantWide)
+        return false;                           // not square
+    for (int row = 0; row < this->mWantTall; row++) {
+        for (int col = 0; col < row; col++) {
+            if (this->mRowWordsNow[row][col] != this->mRowWordsNow[col][row])
+                return false;                   // not symmetric
+        }
+    }
+    return true;                                // square and symmetric
+}
@@ -0,0 +1,79 @@
+// WordGridFinder.hpp : fill any grid of open and blocked cells with words, as in a crossword
+
+#ifndef WordGridFinder_hpp
+#define WordGridFinder_hpp
+
+#include <vector>
+
+#include "WordGrid.hpp"
+#include "WordRectFinder.hpp"
+
+/**
+*   One finder for any WordGrid: rects, lattices, and waffles, as well as crossword grids.
+*   Instead of a subclass with its own search for each pattern of blocked cells, the grid's
+*   mask gives the slots, and the search is driven by them.
+*
+*   The search goes through the open cells in reading order, in steps: each across slot is
+*   one step, at its first cell, and each open cell in no across slot is a step of its own.
+*   An across slot is filled the way WordRectFinder fills a row: by trying the words of its
+*   length in trie order, checking each letter against the down slot through its cell, and
+*   when a word fails at letter k, skipping to the first word with a greater k-letter stem by
+*   the trie links.  A lone cell gets each letter that can come next in its down slot.  Since
+*   every cell above a cell comes before it, the trie node for the down slot up to the cell
+*   above is always known, one per cell, so the same letter is never checked twice.
+*
+*   A grid that is a plain rect is searched exactly as WordRectFinder searches it, node for
+*   node.  Found grids are kept as text rows, with a blank for each blocked or bridged cell.
+*/
+template <typename MapT>
+class WordGridFinder : public WordRectFinder<MapT>
+{
+public:
+    /** Fill grid, which this finder deletes when it is done, from wordTries, indexed by word length. */
+    WordGridFinder(WordTrie<MapT, RectNode> *wordTries[], const WordArray *arrays, const WordGrid *grid, int numToFind, uint options)
+        : WordRectFinder<MapT>(wordTries, arrays, grid->getWide(), grid->getTall(), numToFind, options)
+        , mGrid(grid)
+        , mTries(wordTries)
+    { }
+    WordGridFinder(const WordGridFinder&);              // Prevent pass-by-value by not defining this copy constructor.
+    WordGridFinder& operator=(const WordGridFinder&);   // Prevent assignment by not defining this operator.
+    virtual ~WordGridFinder()
+    {
+        delete mGrid;
+    }
+
+protected:
+    virtual void initRowsAndCols();
+
+private:
+    /** One step of the search: an across slot, or a lone open cell (mSlot < 0), filled from its down slot. */
+    struct GridStep
+    {
+        int             mSlot;
+        uint            mCell;      // the slot's first cell, or the lone cell
+        int             mRow;
+    };
+
+    virtual int  findWordRows();
+    int          findGridSteps(uint step);
+    int          recordFoundGrid();
+    virtual bool isSymmetricSquare() const;
+
+    /** The down slot's node for the letters above cell, to branch from for the letter of cell. */
+    inline const RectNode * downParent(uint cell) const { return *mDownParent[cell]; }
+
+    const WordGrid                    * mGrid;
+    WordTrie<MapT, RectNode>  * const * mTries;
+    std::vector<GridStep>               mSteps;
+    std::vector<const RectNode *>       mSlotRoots;     // root of the trie for each slot's length
+    std::vector<const RectNode *>       mDownNodes;     // per cell: its down slot's node, through the cell's letter
+    std::vector<const RectNode **>      mDownParent;    // per cell: the down node of the cell above, or the slot root
+    std::vector<const RectNode *>       mAcrossNodes;   // per across slot: its root, then the node through each cell
+    std::vector<uint>                   mAcrossBase;    // per slot: where its first cell's node is in mAcrossNodes
+    std::vector<uint>                   mTextPos;       // per cell: where its letter is in the grid text
+    std::vector<char>                   mGridNow;       // the grid being filled, as text rows of mWantWide + 1 chars
+    std::vector<char>                   mGridOld;       // the last grid found
+    std::vector<char>                   mGridDeep;      // the most rows filled so far
+};
+
+#endif // WordGridFinder_hpp
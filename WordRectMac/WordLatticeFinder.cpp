@@ -21,23 +21,27 @@ int WordLatticeFinder<MapT>::findWordRowsUsingTrieLinks(int haveTall)
         this->mState = WordRectFinder<MapT>::eAborted;
         return -this->mMaxTall;  // Abort because a wordRect bigger than wantArea has been found
     }
+    if (this->isPastDeadline()) {
+        this->mState = WordRectFinder<MapT>::eTimedOut;
+        return -this->mMaxTall;  // Abort because this finder's time is up
+    }
 
     int prevTall = haveTall - 1;              // prevTall == -1 is ok.
-    const TrixNode *rowWordNode = NULL;
+    const RectNode *rowWordNode = NULL;
     if (haveTall == 0) {
         rowWordNode = this->mRowTrie.getFirstWordNode();
     } else if (haveTall < this->mWantTall) {
-        uchr uc = this->mColNodes[0][prevTall]->getLetterAt(haveTall);
+        uchr uc = this->mColFront[prevTall][0]->getLetterAt(haveTall);
         uint ux = this->colCharIndex(uc);
         rowWordNode = this->mRowTrie.getFirstWordNodeFromIndex(ux);
         if (this->mMaxTall < haveTall)
-            this->mMaxTall = haveTall;
+            this->recordDeeperRows(haveTall);
     } else {
         // Success: the row just added made words of all columns.
         // Record it right now, right here.
         this->mMaxTall = haveTall;
         for (int row = haveTall - 1, col = 0; col < this->mWantWide; col += 2) {
-            this->mColWordsNow[col] = this->mColNodes[col][row]->getStem();  // Same as getFirstWord() in this context
+            this->mColWordsNow[col] = this->mColFront[row][col]->getStem();  // Same as getFirstWord() in this context
         }
         for (int row = 0; row < haveTall; ++row)
             this->mRowWordsOld[row] = this->mRowWordsNow[row];
@@ -51,7 +55,7 @@ int WordLatticeFinder<MapT>::findWordRowsUsingTrieLinks(int haveTall)
     }
 
     const char *word;
-    const TrixNode **rowNodes = this->mRowNodes[haveTall];
+    const RectNode **rowNodes = this->mRowNodes[haveTall];
     for (int k = 0, kOld = 0, area = 0; rowWordNode != NULL; ) {
         word = rowWordNode->getStem();  // We already know that rowWordNode is a word-node, so its mStem is a word
         for (;;) {
@@ -59,11 +63,11 @@ int WordLatticeFinder<MapT>::findWordRowsUsingTrieLinks(int haveTall)
             // is there a word of length wantTall that could complete it?
             rowNodes[k] = rowNodes[k-1]->getBranchAtIndex(this->rowCharIndex(word[k]));                        // Need this later, so always set it.
             if (k % 2 == 0) {
-                const TrixNode *colBranch = this->mColNodes[k][prevTall]->getBranchAtIndex(this->rowCharIndex(word[k]));   // Need this later only if non-NULL.
+                const RectNode *colBranch = this->mColFront[prevTall][k]->getBranchAtIndex(this->rowCharIndex(word[k]));   // Need this later only if non-NULL.
                 if (colBranch == NULL) {
                     break;                              // ...if not, break to get the next word.
                 }
-                this->mColNodes[k][haveTall] = colBranch;      // ...if so, add the branch node and continue.
+                this->mColFront[haveTall][k] = colBranch;      // ...if so, add the branch node and continue.
             }
             if (k == this->mWantWideM1) {
                 // At least one wantTall-length word exists to complete each column, including this row,
@@ -93,7 +97,7 @@ int WordLatticeFinder<MapT>::findWordRowsUsingTrieLinks(int haveTall)
         // it just by following 2 links:  (failed node)->mNextStemNode->mFirstWordNode.
         // (If we weren't using the rowNodes, we'd need to find the parent of the first
         // disqualified node, as does WordTrie::getNextWordNodeAndIndex, but over all, that is slower.)
-        const TrixNode * nextStem = rowNodes[k]->getNextStemNode();
+        const RectNode * nextStem = rowNodes[k]->getNextStemNode();
         if (nextStem == NULL) {
             return 0;   // We've tried all possible word stems for the partial columns we got, so return. 
         }
@@ -115,10 +119,10 @@ int WordLatticeFinder<MapT>::findWordColsUsingTrieLinks(int row, int col)
         return findWordRowsUsingTrieLinks(row + 2);
     }
 
-    const TrixNode *colNode = this->mColNodes[col][row];
-    const TrixNode *child  = colNode->getFirstChild();
+    const RectNode *colNode = this->mColFront[row][col];
+    const RectNode *child  = colNode->getFirstChild();
     for (int rowP1 = row + 1; child != NULL; child = child->getNextBranch()) {
-        this->mColNodes[col][rowP1] = child;
+        this->mColFront[rowP1][col] = child;
         if (col == 2) {
             zoidDbg++;
         }
@@ -145,23 +149,23 @@ int WordLatticeFinder<MapT>::findWordRowsUsingTrieLinks_iterTodo(int haveTall)
     }
 
     int prevTall = haveTall - 1;
-    const TrixNode *rowWordNode = NULL;
+    const RectNode *rowWordNode = NULL;
     if (haveTall == 0) {
         rowWordNode = this->mRowTrie.getFirstWordNode();
     } else if (haveTall < this->mWantTall) {
-        const TrixNode *firstColNode = this->mColNodes[0][prevTall];
+        const RectNode *firstColNode = this->mColFront[prevTall][0];
         if (haveTall + 1 < this->mWantTall)
-            rowWordNode  = this->mRowTrie.getFirstWordNodeFromIndex(rowCharIndex(this->mColNodes[0][prevTall]->getLetterAt(haveTall+1)));
+            rowWordNode  = this->mRowTrie.getFirstWordNodeFromIndex(rowCharIndex(this->mColFront[prevTall][0]->getLetterAt(haveTall+1)));
         else
             rowWordNode = this->mRowTrie.getFirstWordNode();
 
-        const TrixNode *rowWordNodeB = firstColNode->getFirstChild()->getFirstWordNode();
+        const RectNode *rowWordNodeB = firstColNode->getFirstChild()->getFirstWordNode();
         if (rowWordNode != rowWordNodeB) {
             zoidDbg++;
         }
 
         if (this->mMaxTall < haveTall)
-            this->mMaxTall = haveTall;
+            this->recordDeeperRows(haveTall);
     } else {
         // Success: the row just added made words of all columns.
         // Record it right now, right here.
@@ -178,7 +182,7 @@ int WordLatticeFinder<MapT>::findWordRowsUsingTrieLinks_iterTodo(int haveTall)
     }
 
     if (haveTall % 2 == 0) {
-        const TrixNode **rowNodes = this->mRowNodes[haveTall];
+        const RectNode **rowNodes = this->mRowNodes[haveTall];
         for (int k = 0; rowWordNode != NULL; ) {
             const char *word = rowWordNode->getStem();  // We already know that rowWordNode is a word-node, so its mStem is a word
             for (;;) {
@@ -187,9 +191,9 @@ int WordLatticeFinder<MapT>::findWordRowsUsingTrieLinks_iterTodo(int haveTall)
                 rowNodes[k] = rowNodes[k-1]->getBranchAtIndex(this->rowCharIndex(word[k]));                        // Need this later, so always set it.
 
                 if (k % 2 == 0) {
-                    const TrixNode *colNodeK = this->mColNodes[k][prevTall];
-                    const TrixNode *branch = colNodeK->getFirstChild();
-                    const TrixNode *colBranch = NULL;
+                    const RectNode *colNodeK = this->mColFront[prevTall][k];
+                    const RectNode *branch = colNodeK->getFirstChild();
+                    const RectNode *colBranch = NULL;
                     for ( ; branch != NULL; branch = branch->getNextBranch()) {
                         colBranch = branch->getBranchAtIndex(this->colCharIndex(word[k]));   // Need this later only if non-NULL.
                         if (colBranch != NULL) 
@@ -198,7 +202,7 @@ int WordLatticeFinder<MapT>::findWordRowsUsingTrieLinks_iterTodo(int haveTall)
                     if (colBranch == NULL) {
                         break;                              // ...if not, break to get the next word.
                     }
-                    this->mColNodes[k][haveTall] = colBranch;      // ...if so, add the branch node and continue.
+                    this->mColFront[haveTall][k] = colBranch;      // ...if so, add the branch node and continue.
                 }
                 if (k >= this->mWantWideM1) {
                     // At least one wantTall-length word exists to complete each column, including this row,
@@ -219,7 +223,7 @@ int WordLatticeFinder<MapT>::findWordRowsUsingTrieLinks_iterTodo(int haveTall)
             // it just by following 2 links:  (failed node)->mNextStemNode->mFirstWordNode.
             // (If we weren't using the rowNodes, we'd need to find the parent of the first
             // disqualified node, as does WordTrie::getNextWordNodeAndIndex, but over all, that is slower.)
-            const TrixNode * nextStem = rowNodes[k]->getNextStemNode();
+            const RectNode * nextStem = rowNodes[k]->getNextStemNode();
             if (nextStem == NULL) {
                 return 0;   // We've tried all possible word stems for the partial columns we got, so return. 
             }
@@ -228,7 +232,7 @@ int WordLatticeFinder<MapT>::findWordRowsUsingTrieLinks_iterTodo(int haveTall)
         }
     } else { // haveTall is odd
         for (int k = 0; k < this->mWantWide; k += 2) {
-            this->mColNodes[k][haveTall] = this->mColNodes[prevTall][k]->getFirstChild();
+            this->mColFront[haveTall][k] = this->mColFront[k][prevTall]->getFirstChild();
         }
 
     }
@@ -242,13 +246,13 @@ bool WordLatticeFinder<MapT>::isSymmetricSquare() const
         return false;                           // not square
     for (int row = 0; row < this->mWantTall; ++row) {
         for (int col = this->mWantWide; --col >= 0; ) {
-            if (this->mRowNodes[row][col] != this->mColNodes[row][col])
+            if (this->mRowNodes[row][col] != this->mColFront[col][row])
                 return false;                   // not symmetric
         }
         if (++row == this->mWantTall)
             break;
         for (int col = 0; col < this->mWantWide; col += 2) {
-            if (this->mRowNodes[row][col] != this->mColNodes[row][col])
+            if (this->mRowNodes[row][col] != this->mColFront[col][row])
                 return false;                   // not symmetric
         }
     }
@@ -261,18 +265,18 @@ template <typename MapT>
 void WordLatticeFinder<MapT>::printWordRows(const char *wordRows[], int haveTall) const
 {
     for (int row = haveTall - 1, col = 0; col < this->mWantWide; col += 2) {
-        this->mColWordsNow[col] = this->mColNodes[col][row]->getStem(); // same as getFirstWord() in this context
+        this->mColWordsNow[col] = this->mColFront[row][col]->getStem(); // same as getFirstWord() in this context
     }
 
     for (int row = 0; row < haveTall; ++row) {
         for (const char *pc = wordRows[row]; *pc != '\0'; pc++) {
-            printf(" %c", *pc);
+            printf(" %s", CodePointMap::getText(*pc));
         }
         printf("\n");
         if (++row == haveTall)
             break;
         for (int col = 0; col < this->mWantWide; col += 2) {
-            printf(" %c  ", this->mColWordsNow[col][row]);
+            printf(" %s  ", CodePointMap::getText(this->mColWordsNow[col][row]));
         }
         printf("\n");
     }
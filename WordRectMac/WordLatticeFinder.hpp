@@ -24,8 +24,8 @@ class WordLatticeFinder : public WordRectFinder<MapT>
 {
 public:
 
-    WordLatticeFinder(WordTrie<MapT, TrixNode> *wordTries[], const WordMap *maps, int wide, int tall, int numToFind, uint options) 
-        : WordRectFinder<MapT>(wordTries, maps, wide, tall, numToFind, options)
+    WordLatticeFinder(WordTrie<MapT, RectNode> *wordTries[], const WordArray *arrays, int wide, int tall, int numToFind, uint options) 
+        : WordRectFinder<MapT>(wordTries, arrays, wide, tall, numToFind, options)
     { 
         mColWordsNow = (const char**) new char*[wide];
     }
@@ -0,0 +1,80 @@
+// WordListFile.cpp : a word list text file read once into memory, with its words marked in place
+
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "wordPlatform.h"
+#include "CharFreqMap.hpp"
+#include "WordListFile.hpp"
+#include "WordScanner.hpp"
+
+int WordListFile::load(const char *fileSpec, uint minWordLength, uint maxWordLength)
+{
+    FILE *fi;
+    if (fopen_safe(&fi, fileSpec, "rb") != 0) {
+        printf("Error opening dictionary file: %s\n", fileSpec);
+        return -1;
+    }
+    long fileSize = -1;
+    if (fseek(fi, 0, SEEK_END) == 0)
+        fileSize = ftell(fi);
+    if (fileSize < 0 || fseek(fi, 0, SEEK_SET) != 0) {
+        printf("Error finding the size of dictionary file: %s\n", fileSpec);
+        fclose(fi);
+        return -1;
+    }
+    delete [] mText;
+    mText = new char[fileSize + 2];
+    mTextSize = fread(mText, 1, (size_t)fileSize, fi);
+    fclose(fi);
+    printf("%s read by %s (%lu bytes)\n", fileSpec, __FUNCTION__, (unsigned long)mTextSize);
+
+    // Ending the text with a line end means every word ends before the end of the buffer.
+    mText[mTextSize]     = '\n';
+    mText[mTextSize + 1] = '\0';
+
+    if (mCodePoints.init(mText, mTextSize)) {
+        printf("%s is UTF-8; encoding its words one byte per char", fileSpec);
+        if (mCodePoints.getNumUnmapped() > 0)
+            printf(" (dropping those with any of the %u rarest chars)", mCodePoints.getNumUnmapped());
+        printf(".\n");
+    }
+
+    mWords.clear();
+    mLengths.clear();
+    memset(mCharCounts, 0, sizeof(mCharCounts));
+    mMinFoundWordLength = UINT_MAX;
+    mMaxFoundWordLength = 0;
+    const char *textEnd = mText + mTextSize;
+    for (char *pc = mText; pc < textEnd; ) {
+        // The first word of the line is every char before the first one <= Space,
+        // which also ends it (as in CharFreqMap::extractFirstWord).
+        char *word = pc;
+        pc = word + (WordScanner::findSpace(word, textEnd + 1) - word);     // the same char, but writable
+        uint length = uint(pc - word);      // pointer arithmetic
+        bool isLineEnd = (*pc == '\n');
+        *pc++ = '\0';
+        if ( ! isLineEnd)                   // skip the rest of the line; the last one ends at textEnd
+            pc = (char *)memchr(pc, '\n', textEnd + 1 - pc) + 1;
+        if (mCodePoints.isActive()) {
+            int numChars = mCodePoints.encode(word, length);
+            if (numChars < 0)
+                continue;
+            length = (uint)numChars;
+        }
+
+        if (mMinFoundWordLength > length)
+            mMinFoundWordLength = length;
+        if (mMaxFoundWordLength < length)
+            mMaxFoundWordLength = length;
+        if (length < minWordLength || maxWordLength < length)
+            continue;
+
+        mWords.push_back(word);
+        mLengths.push_back(length);
+        for (uint j = 0; j < length; j++)
+            ++mCharCounts[(uchr)word[j]];
+    }
+    return (int)mWords.size();
+}
@@ -0,0 +1,56 @@
+// WordListFile.hpp : a word list text file read once into memory, with its words marked in place
+
+#ifndef WordListFile_hpp
+#define WordListFile_hpp
+
+#include <vector>
+
+#include "CodePointMap.hpp"
+#include "wordTypes.h"
+
+/**
+*   The dictionary file, read with a single fread into one buffer, which holds the words
+*   until the tries have copied them into their pools (see WordPool).  One pass over the
+*   buffer finds the first word of each
+*   line (every char up to the first one <= Space), terminates it with a NULL in place,
+*   and counts its chars, so that CharFreqMap gets its counts from here instead of from
+*   another read of the file (see CharFreqMap::initFromWordList).
+*   Only the words in the range of lengths asked for are kept (and their chars counted),
+*   in file order, but the lengths found are over all the lines, as CharFreqMap reports them.
+*   A UTF-8 file with multi-byte chars has its words encoded in place, one byte per char (see
+*   CodePointMap), before they are measured or counted; words it cannot encode are dropped.
+*/
+class WordListFile
+{
+public:
+    static const uint sNumChars = 256;      // char counts are indexed by unsigned char value
+
+    WordListFile() : mText(NULL), mTextSize(0), mMinFoundWordLength(0), mMaxFoundWordLength(0) { }
+    WordListFile(const WordListFile&);              // Prevent pass-by-value by not defining this copy constructor.
+    WordListFile& operator=(const WordListFile&);   // Prevent assignment by not defining this operator.
+    ~WordListFile() { delete [] mText; }
+
+    /** Read the file and mark its words.  Returns the number of words kept, or -1 if the file cannot be read. */
+    int                 load(const char *fileSpec, uint minWordLength, uint maxWordLength);
+
+    inline uint         getNumWords()               const   { return (uint)mWords.size(); }
+    inline const char * getWord(uint j)             const   { return mWords[j]; }
+    inline uint         getLength(uint j)           const   { return mLengths[j]; }
+    inline const uint * getCharCounts()             const   { return mCharCounts; }
+    inline uint         getMinFoundWordLength()     const   { return mMinFoundWordLength; }
+    inline uint         getMaxFoundWordLength()     const   { return mMaxFoundWordLength; }
+    inline size_t       getTextSize()               const   { return mTextSize; }
+    inline const CodePointMap & getCodePointMap()   const   { return mCodePoints; }
+
+private:
+    char              * mText;              // the whole file, plus a line end and a NULL
+    size_t              mTextSize;
+    std::vector<const char *> mWords;       // first word of each line, NULL-terminated in mText
+    std::vector<uint>   mLengths;
+    uint                mCharCounts[sNumChars];
+    uint                mMinFoundWordLength;
+    uint                mMaxFoundWordLength;
+    CodePointMap        mCodePoints;        // active only for UTF-8 text with multi-byte chars
+};
+
+#endif // WordListFile_hpp
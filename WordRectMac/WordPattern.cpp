@@ -0,0 +1,54 @@
+// WordPattern.cpp : a crossword-style pattern for words of one length, such as c?o?s??d or qu[ai]ck
+
+#include <string.h>
+
+#include "WordPattern.hpp"
+
+bool WordPattern::parse(const char *text)
+{
+    mText = text;
+    mPositions.clear();
+    for (const uchr *pc = (const uchr *)text; *pc != '\0'; pc++) {
+        CharSet set;
+        memset(set.mBits, 0, sizeof(set.mBits));
+        if (*pc == '?') {
+            memset(set.mBits, 0xFF, sizeof(set.mBits));
+        } else if (*pc == '[') {
+            bool negate = (pc[1] == '^');
+            if (negate)
+                pc++;
+            for (pc++; *pc != ']'; pc++) {
+                if (*pc == '\0') {
+                    mPositions.clear();
+                    return false;       // no closing bracket
+                }
+                set.mBits[*pc >> 5] |= 1u << (*pc & 31);
+            }
+            if (negate) {
+                for (uint j = 0; j < 8; j++)
+                    set.mBits[j] = ~set.mBits[j];
+            }
+        } else {
+            set.mBits[*pc >> 5] |= 1u << (*pc & 31);
+        }
+        set.mBits[0] &= ~1u;            // never the NULL
+
+        // Note the only char, if there is just one, so a matcher can go straight to it.
+        set.mOnlyChar = -1;
+        uint numChars = 0;
+        for (uint uc = 1; uc < 256; uc++) {
+            if ((set.mBits[uc >> 5] >> (uc & 31)) & 1) {
+                set.mOnlyChar = (int)uc;
+                numChars++;
+            }
+        }
+        if (numChars == 0) {
+            mPositions.clear();
+            return false;
+        }
+        if (numChars > 1)
+            set.mOnlyChar = -1;
+        mPositions.push_back(set);
+    }
+    return true;
+}
@@ -0,0 +1,49 @@
+// WordPattern.hpp : a crossword-style pattern for words of one length, such as c?o?s??d or qu[ai]ck
+
+#ifndef WordPattern_hpp
+#define WordPattern_hpp
+
+#include <string>
+#include <vector>
+
+#include "wordTypes.h"
+
+/**
+*   One set of allowed chars per position of a word, parsed from text:
+*       ?           any char
+*       [abc]       any of the chars listed
+*       [^abc]      any char but those listed
+*       anything else is just that char.
+*   So "c?o?s??d" matches the 8-letter words with c, o, s, and d in those places, and
+*   "??????[^aeiou]" the 7-letter words that do not end in a vowel.
+*   See WordPatternMatcher for finding the words in a trie that match.
+*/
+class WordPattern
+{
+public:
+    WordPattern() { }
+
+    /** Parse text into this pattern.  Returns false (and leaves it empty) on an unclosed [ or an empty set. */
+    bool                parse(const char *text);
+
+    inline uint         getLength()                 const   { return (uint)mPositions.size(); }
+    inline const char * getText()                   const   { return mText.c_str(); }
+
+    /** Does position pos allow char uc? */
+    inline bool         allows(uint pos, uchr uc)   const   { return (mPositions[pos].mBits[uc >> 5] >> (uc & 31)) & 1; }
+
+    /** The one char position pos allows, or -1 if it allows more (or none). */
+    inline int          getOnlyChar(uint pos)       const   { return mPositions[pos].mOnlyChar; }
+
+private:
+    struct CharSet
+    {
+        uint    mBits[8];       // one bit per uchr (uint is 32 bits)
+        int     mOnlyChar;
+    };
+
+    std::string             mText;
+    std::vector<CharSet>    mPositions;
+};
+
+#endif // WordPattern_hpp
@@ -0,0 +1,146 @@
+// WordPatternMatcher.hpp : find the words in a WordTrie that match one or many WordPatterns
+
+#ifndef WordPatternMatcher_hpp
+#define WordPatternMatcher_hpp
+
+#include <vector>
+
+#include "WordPattern.hpp"
+#include "WordTrie.hpp"
+
+/**
+*   Walks a WordTrie down only the branches a pattern allows, and hands each matching word
+*   to a callback as soon as it is found, so nothing is collected unless the caller wants it.
+*
+*   matchAll takes any number of patterns and walks the trie once for all of them: each node
+*   carries the set of patterns still alive at its depth, so patterns that share a prefix
+*   (c?o?s??d and c?o?s??s, or thousands of crossword slots with the same first letters)
+*   share the nodes for it.  Where every live pattern allows just one char, the next node is
+*   found by its index; otherwise the node's own child list is walked, and each child goes
+*   only to the patterns that allow its char.  Either way, branches no pattern allows are
+*   never entered.
+*
+*   Works on fixed-length tries (patterns of any other length match nothing) and on
+*   variable-length tries such as the TracNode tries of texts.
+*/
+template <typename MapT, typename NodeT>
+class WordPatternMatcher
+{
+public:
+    /** Called for each word that matches the pattern at patternIdx.  Return false to stop matching. */
+    typedef bool (*MatchFunc)(uint patternIdx, const char *word, void *context);
+
+    WordPatternMatcher(const WordTrie<MapT, NodeT>& trie) : mTrie(trie), mPatterns(NULL), mFunc(NULL), mContext(NULL), mNumMatched(0) { }
+    WordPatternMatcher(const WordPatternMatcher&);              // Prevent pass-by-value by not defining this copy constructor.
+    WordPatternMatcher& operator=(const WordPatternMatcher&);   // Prevent assignment by not defining this operator.
+
+    /** Pass each word matching pattern to func (with patternIdx 0), and return how many were passed. */
+    uint match(const WordPattern& pattern, MatchFunc func, void *context)
+    {
+        return matchAll(&pattern, 1, func, context);
+    }
+
+    /**
+    * Pass each word matching any of patterns[0, numPatterns) to func, once for each pattern it
+    * matches, in trie order, and return how many were passed (up to and including the one for
+    * which func returned false, if it did).
+    */
+    uint matchAll(const WordPattern patterns[], uint numPatterns, MatchFunc func, void *context)
+    {
+        mPatterns   = patterns;
+        mFunc       = func;
+        mContext    = context;
+        mNumMatched = 0;
+
+        uint maxLength = 0, trieLength = (uint)mTrie.getWordLength();
+        if (mLive.empty())
+            mLive.resize(1);
+        mLive[0].clear();
+        for (uint j = 0; j < numPatterns; j++) {
+            uint length = patterns[j].getLength();
+            if (length == 0 || (trieLength > 0 && length != trieLength))
+                continue;
+            mLive[0].push_back(j);
+            if (maxLength < length)
+                maxLength = length;
+        }
+        if (mLive[0].empty())
+            return 0;
+        if (mLive.size() < maxLength + 1)
+            mLive.resize(maxLength + 1);  // one set of live patterns per depth, reused from call to call
+        matchFrom(mTrie.getRoot(), 0);
+        return mNumMatched;
+    }
+
+private:
+    /** Match the live patterns at this depth below node.  Returns false if the callback said stop. */
+    bool matchFrom(const NodeT *node, uint depth)
+    {
+        const std::vector<uint>& live = mLive[depth];
+
+        // Report the patterns that end here, and pass on only the ones that go deeper.
+        // If all of those allow just the same one char next, go straight to its branch.
+        int onlyChar = -1;
+        uint numDeeper = 0;
+        for (uint j = 0; j < live.size(); j++) {
+            const WordPattern& pattern = mPatterns[live[j]];
+            if (pattern.getLength() == depth) {
+                const char *word = node->getWord();
+                if (word != NULL) {
+                    ++mNumMatched;
+                    if ( ! mFunc(live[j], word, mContext))
+                        return false;
+                }
+                continue;
+            }
+            int uc = pattern.getOnlyChar(depth);
+            if (numDeeper++ == 0)
+                onlyChar = uc;
+            else if (onlyChar != uc)
+                onlyChar = -1;
+        }
+        if (numDeeper == 0)
+            return true;
+        std::vector<uint>& next = mLive[depth + 1];
+
+        if (onlyChar >= 0) {
+            const MapT& charMap = mTrie.charMap();
+            if (onlyChar < (int)charMap.sourceMinChar() || (int)charMap.sourceMaxChar() < onlyChar)
+                return true;
+            uint idx = mTrie.charIndex((uchr)onlyChar);
+            if (idx >= charMap.targetEndIdx())
+                return true;
+            const NodeT *child = node->getBranchAtIndex(idx);
+            if (child == NULL || child->getLetterAt(depth) != (uchr)onlyChar)   // a wild index may hold other chars
+                return true;
+            next.clear();
+            for (uint j = 0; j < live.size(); j++) {
+                if (mPatterns[live[j]].getLength() > depth)
+                    next.push_back(live[j]);
+            }
+            return matchFrom(child, depth + 1);
+        }
+
+        for (const NodeT *child = node->getFirstChild(); child != NULL; child = child->getNextBranch()) {
+            uchr uc = child->getLetterAt(depth);
+            next.clear();
+            for (uint j = 0; j < live.size(); j++) {
+                const WordPattern& pattern = mPatterns[live[j]];
+                if (pattern.getLength() > depth && pattern.allows(depth, uc))
+                    next.push_back(live[j]);
+            }
+            if ( ! next.empty() && ! matchFrom(child, depth + 1))
+                return false;
+        }
+        return true;
+    }
+
+    const WordTrie<MapT, NodeT>   & mTrie;
+    const WordPattern             * mPatterns;
+    MatchFunc                       mFunc;
+    void                          * mContext;
+    uint                            mNumMatched;
+    std::vector< std::vector<uint> > mLive;    // indices of the patterns still matching, by depth
+};
+
+#endif // WordPatternMatcher_hpp
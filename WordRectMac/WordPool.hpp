@@ -0,0 +1,50 @@
+// WordPool.hpp : one block of memory holding words of the same length, back to back
+
+#ifndef WordPool_hpp
+#define WordPool_hpp
+
+#include <string.h>
+
+#include "wordTypes.h"
+
+/**
+*   Fixed-stride arena for the words of one fixed-length trie: each word is a record
+*   of its letters and a NULL, in one block, and all the words are freed at once.
+*   The capacity is set up front, and never grows, because the nodes keep pointers
+*   to the words (see WordTrie::reserveWords).  Words go in as the trie inserts them,
+*   which is in sorted order, so the pool is also the trie's word list, and the words
+*   a search reads one after another lie next to each other in memory.
+*/
+class WordPool
+{
+public:
+    WordPool(uint wordLength, uint capacity)
+        : mStride(wordLength + 1), mCapacity(capacity), mNumWords(0)
+        , mBlock(new char[(size_t)(wordLength + 1) * (capacity > 0 ? capacity : 1)])
+    { }
+    WordPool(const WordPool&);              // Prevent pass-by-value by not defining this copy constructor.
+    WordPool& operator=(const WordPool&);   // Prevent assignment by not defining this operator.
+    ~WordPool() { delete [] mBlock; }
+
+    /** Copy word (of exactly the pool's length) into the next record, or return NULL if the pool is full. */
+    inline const char * add(const char *word)
+    {
+        if (mNumWords == mCapacity)
+            return NULL;
+        char *record = mBlock + (size_t)mNumWords++ * mStride;
+        memcpy(record, word, mStride - 1);
+        record[mStride - 1] = '\0';
+        return record;
+    }
+
+    /** Is word one of the records in this pool (as opposed to a copy the trie made on its own)? */
+    inline bool         contains(const char *word)  const   { return mBlock <= word && word < mBlock + (size_t)mNumWords * mStride; }
+
+private:
+    const uint          mStride;            // word length plus the NULL
+    const uint          mCapacity;
+    uint                mNumWords;
+    char              * mBlock;
+};
+
+#endif // WordPool_hpp
@@ -0,0 +1,97 @@
+// WordRectAnytimeFinder.cpp : find word rectangles within a time budget, best guesses first
+
+#include "WordRectAnytimeFinder.hpp"
+#include "WordRectSearchMgr.hpp"
+
+template <typename MapT>
+int WordRectAnytimeFinder<MapT>::findWordRows()
+{
+    for (mMaxDiscrepancy = 0; ; ++mMaxDiscrepancy) {
+        mCutOff = false;
+        int area = findWordRowsWithDiscrepancies(0, mMaxDiscrepancy);
+        if (area < 0 || (area > 0 && this->getNumFound() == this->getNumToFind())) {
+            return area;                    // aborted, timed out, or found enough
+        }
+        if (WordRectSearchMgr<MapT>::getVerbosity() > 2) {
+            printf("Anytime %2d * %2d: pass %d found %d rects, max %d rows, after %d seconds\n"
+                , this->mWantWide, this->mWantTall, mMaxDiscrepancy, this->getNumFound(), this->mMaxTall
+                , (int)(time(NULL) - this->mStartTime));
+        }
+        if ( ! mCutOff ) {
+            return this->getNumFound() > 0 ? this->mWantArea : 0;  // this pass was exhaustive
+        }
+    }
+}
+
+/**
+* Same as WordRectFinder::findWordRowsUsingTrieLinks, except that the k-th row word
+* that fits all the columns costs k discrepancies, and no path may cost more than
+* the discrepancies it was given.
+*/
+template <typename MapT>
+int WordRectAnytimeFinder<MapT>::findWordRowsWithDiscrepancies(int haveTall, int discrepancies)
+{
+    this->mNowTall = haveTall;
+    if (haveTall > 1 && this->mWantArea <= WordRectSearchMgr<MapT>::getTrumpingArea()) {
+        this->mState = WordRectFinder<MapT>::eAborted;
+        return -this->mWantArea;  // Abort because a wordRect bigger than wantArea has been found
+    }
+    if (this->isPastDeadline()) {
+        this->mState = WordRectFinder<MapT>::eTimedOut;
+        return -this->mWantArea;  // Abort because this finder's time is up
+    }
+
+    int prevTall = haveTall - 1;              // prevTall == -1 is ok.
+    const RectNode *rowWordNode = NULL;
+    if (haveTall == 0) {
+        rowWordNode = this->mRowTrie.getFirstWordNode();
+    } else if (haveTall < this->mWantTall) {
+        uchr letter = this->mColFront[prevTall][0]->getLetterAt(haveTall);
+        uint index = this->rowCharIndex(letter);
+        rowWordNode = this->mRowTrie.getFirstWordNodeFromIndex(index);
+        if (this->mMaxTall < haveTall)
+            this->recordDeeperRows(haveTall);
+    } else if (discrepancies == 0) {
+        // Success: the row just added made words of all columns.
+        return this->recordFoundRect(haveTall);
+    } else {
+        return 0;   // Already found in an earlier pass, with fewer discrepancies
+    }
+
+    const RectNode **rowNodes = this->mRowNodes[haveTall];
+    int cost = 0;                             // discrepancies spent by taking the next fitting word
+    for (int k = 0; rowWordNode != NULL; ) {
+        const char *word = rowWordNode->getStem();
+        for (;;) {
+            uchr letter = word[k];
+            uint index  = this->rowCharIndex(letter);
+            rowNodes[k] = rowNodes[k-1]->getBranchAtIndex(index);
+            const RectNode *colBranch = this->mColFront[prevTall][k]->getBranchAtIndex(index);
+            if (colBranch == NULL) {
+                break;
+            }
+            this->mColFront[haveTall][k] = colBranch;
+            if (k == this->mWantWideM1) {
+                if (cost > discrepancies) {
+                    mCutOff = true;           // Leave this word and the rest for a later pass.
+                    return 0;
+                }
+                this->mRowWordsNow[haveTall] = word;
+                int area = findWordRowsWithDiscrepancies(haveTall+1, discrepancies - cost);
+                if (area < 0 || (area > 0 && this->getNumFound() == this->getNumToFind())) {
+                    return area;
+                }
+                ++cost;
+                break;
+            }
+            k++;
+        }
+        const RectNode * nextStem = rowNodes[k]->getNextStemNode();
+        if (nextStem == NULL) {
+            return 0;
+        }
+        k = nextStem->getDepth() - 1;
+        rowWordNode = nextStem->getFirstWordNode();
+    }
+    return 0;
+}
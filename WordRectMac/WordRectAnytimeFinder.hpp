@@ -0,0 +1,42 @@
+// WordRectAnytimeFinder.hpp : find word rectangles within a time budget, best guesses first
+
+#ifndef WordRectAnytimeFinder_hpp
+#define WordRectAnytimeFinder_hpp
+
+#include "WordRectFinder.hpp"
+
+/**
+*   Anytime variant of the word rect finder, for use with a time budget (deadline).
+*   Instead of plain depth-first order, it uses iterative limited discrepancy search:
+*   at each row, taking the i-th (0-based) row word that fits all the column stems
+*   costs i discrepancies, and pass d explores only the paths costing at most d in total.
+*   So the first passes sample the whole search tree thinly, and each later pass goes
+*   wider, until the deadline passes or some pass is not cut off anywhere (which means
+*   it was exhaustive).  Each complete rect is counted only in the pass that spends
+*   exactly its cost, so no rect is counted twice.  The deepest partial rect so far
+*   is kept by the base class, so it can be reported when time runs out.
+*/
+template <typename MapT>
+class WordRectAnytimeFinder : public WordRectFinder<MapT>
+{
+public:
+    WordRectAnytimeFinder(WordTrie<MapT, RectNode> *wordTries[], const WordArray *arrays, int wide, int tall, uint numToFind, uint options)
+        : WordRectFinder<MapT>(wordTries, arrays, wide, tall, numToFind, options)
+        , mMaxDiscrepancy(0), mCutOff(false)
+    { }
+
+    WordRectAnytimeFinder(const WordRectAnytimeFinder&);              // Prevent pass-by-value by not defining this copy constructor.
+    WordRectAnytimeFinder& operator=(const WordRectAnytimeFinder&);   // Prevent assignment by not defining this operator.
+    virtual ~WordRectAnytimeFinder() { }
+
+    inline int          getMaxDiscrepancy() const   { return mMaxDiscrepancy; }
+
+private:
+    virtual int  findWordRows();
+    int          findWordRowsWithDiscrepancies(int haveTall, int discrepancies);
+
+    int                 mMaxDiscrepancy;        // discrepancy limit of the current pass
+    bool                mCutOff;                // Did the current pass skip any candidate for lack of discrepancies?
+};
+
+#endif // WordRectAnytimeFinder_hpp
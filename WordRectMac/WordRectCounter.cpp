@@ -0,0 +1,209 @@
+// WordRectCounter.cpp : count or uniformly sample all word rects of a short shape by dynamic programming
+
+#include <string.h>
+
+#include "WordRectCounter.hpp"
+
+template <typename MapT>   const uint  WordRectCounter<MapT>::sNone;
+
+template <typename MapT>
+WordRectCounter<MapT>::WordRectCounter(WordTrie<MapT, RectNode> *wordTries[], int wide, int tall)
+    : mRowTrie(*wordTries[wide])
+    , mColTrie(*wordTries[tall])
+    , mWantWide(wide)
+    , mWantTall(tall)
+    , mBegIdx(wordTries[tall]->charMap().targetBegIdx())
+    , mNumIdx(wordTries[tall]->charMap().targetSize())
+    , mNumClasses(0), mRootClass(sNone), mLeafClass(sNone)
+    , mNextIds((tall + 1) * wide, 0)
+    , mStates(wide)
+    , mCounted(false), mCount(0)
+{
+    assert(tall <= sMaxTall);
+}
+
+/** Suffix-equivalence class of a column-trie node: nodes whose sub-tries are the same share an ID. */
+template <typename MapT>
+uint WordRectCounter<MapT>::classify(const RectNode *node)
+{
+    std::vector<uint> signature(mNumIdx, sNone);
+    for (const RectNode *child = node->getFirstChild(); child != NULL; child = child->getNextBranch()) {
+        signature[letterIndex(child)] = classify(child);
+    }
+    std::map<std::vector<uint>, uint>::const_iterator found = mSignatures.find(signature);
+    if (found != mSignatures.end())
+        return found->second;
+    uint id = mNumClasses++;
+    mSignatures.insert(std::make_pair(signature, id));
+    mNext.insert(mNext.end(), signature.begin(), signature.end());
+    return id;
+}
+
+template <typename MapT>
+uint64 WordRectCounter<MapT>::count()
+{
+    if ( ! mCounted ) {
+        mRootClass = classify(mColTrie.getRoot());
+        mSignatures.clear();                    // needed only while classifying
+        mLeafClass = 0;                         // the first class made is the one with no branches
+        for (uint id = 0; id < mNumClasses; id++) {
+            mBranchBeg.push_back((uint)mBranchIdx.size());
+            for (uint idx = 0; idx < mNumIdx; idx++) {
+                if (mNext[id * mNumIdx + idx] != sNone) {
+                    mBranchIdx.push_back(mBegIdx + idx);
+                    mBranchNext.push_back(mNext[id * mNumIdx + idx]);
+                }
+            }
+        }
+        mBranchBeg.push_back((uint)mBranchIdx.size());
+        std::vector<uint> ids(mWantWide, mRootClass);
+        bool noWords = mRowTrie.getRoot()->getFirstChild() == NULL || mColTrie.getRoot()->getFirstChild() == NULL;
+        mCount = noWords ? 0 : countFrom(&ids[0], 0);
+        mCounted = true;
+    }
+    return mCount;
+}
+
+/** Number of ways to finish the rect from this state; the columns' depth is the number of rows so far. */
+template <typename MapT>
+uint64 WordRectCounter<MapT>::countFrom(const uint *ids, int haveTall)
+{
+    if (ids[0] == mLeafClass)
+        return 1;                               // all the columns are words
+    const uint64 *memo = mStates.find(ids);
+    if (memo != NULL)
+        return *memo;
+    uint64 num = addRows(mRowTrie.getRoot(), 0, ids, &mNextIds[haveTall * mWantWide], haveTall);
+    mStates.insert(ids, num);
+    return num;
+}
+
+/**
+* Walk the row trie down from rowNode, which holds this row's letters for columns
+* left of col, and add up the completions of each state that a whole row word leads to.
+*/
+template <typename MapT>
+uint64 WordRectCounter<MapT>::addRows(const RectNode *rowNode, int col, const uint *ids, uint *nextIds, int haveTall)
+{
+    if (col == mWantWide)
+        return countFrom(nextIds, haveTall + 1);
+    uint64 num = 0;
+    for (uint j = mBranchBeg[ids[col]], end = mBranchBeg[ids[col] + 1]; j < end; j++) {
+        const RectNode *child = rowNode->getBranchAtIndex(mBranchIdx[j]);
+        if (child != NULL) {
+            nextIds[col] = mBranchNext[j];
+            num += addRows(child, col + 1, ids, nextIds, haveTall);
+        }
+    }
+    return num;
+}
+
+template <typename MapT>
+bool WordRectCounter<MapT>::sample(WordRandom& random, const char *rowWords[])
+{
+    uint64 total = count();
+    if (total == 0)
+        return false;
+
+    std::vector<uint> ids(mWantWide, mRootClass), nextIds(mWantWide, 0);
+    for (int row = 0; row < mWantTall; row++) {
+        uint64 target = random.next() % countFrom(&ids[0], row);    // modulo bias is below count / 2^64
+        const char *rowWord = NULL;
+        if ( ! pickRow(mRowTrie.getRoot(), 0, &ids[0], &nextIds[0], row, target, rowWord))
+            return false;                       // cannot happen if the counts are right
+        rowWords[row] = rowWord;
+        ids.swap(nextIds);
+    }
+    return true;
+}
+
+/** Find the row word whose completions contain the target'th completion from this state. */
+template <typename MapT>
+bool WordRectCounter<MapT>::pickRow(const RectNode *rowNode, int col, const uint *ids, uint *nextIds
+    , int haveTall, uint64& target, const char *&rowWord)
+{
+    if (col == mWantWide) {
+        uint64 num = countFrom(nextIds, haveTall + 1);
+        if (target < num) {
+            rowWord = rowNode->getStem();
+            return true;
+        }
+        target -= num;
+        return false;
+    }
+    for (uint j = mBranchBeg[ids[col]], end = mBranchBeg[ids[col] + 1]; j < end; j++) {
+        const RectNode *child = rowNode->getBranchAtIndex(mBranchIdx[j]);
+        if (child != NULL) {
+            nextIds[col] = mBranchNext[j];
+            if (pickRow(child, col + 1, ids, nextIds, haveTall, target, rowWord))
+                return true;
+        }
+    }
+    return false;
+}
+
+template <typename MapT>
+WordRectCounter<MapT>::StateTable::StateTable(uint keyLength) : mKeyLength(keyLength), mMaxSize(1), mSize(0)
+{
+    uint64 slotBytes = keyLength * sizeof(uint) + sizeof(uint64);
+    while ((uint64)mMaxSize * 4 * slotBytes <= sMaxBytes)
+        mMaxSize *= 2;                          // kept at most half full, in a power-of-2 number of slots
+    rehash(1 << 12);
+}
+
+template <typename MapT>
+uint64 WordRectCounter<MapT>::StateTable::hash(const uint *ids) const
+{
+    uint64 h = 0xCBF29CE484222325ULL;
+    for (uint col = 0; col < mKeyLength; col++) {
+        h ^= ids[col];
+        h *= 0x100000001B3ULL;
+    }
+    return h ^ (h >> 29);
+}
+
+template <typename MapT>
+const uint64 * WordRectCounter<MapT>::StateTable::find(const uint *ids) const
+{
+    for (uint slot = (uint)hash(ids) & mMask; mUsed[slot]; slot = (slot + 1) & mMask) {
+        if (memcmp(&mKeys[slot * mKeyLength], ids, mKeyLength * sizeof(uint)) == 0)
+            return &mVals[slot];
+    }
+    return NULL;
+}
+
+template <typename MapT>
+void WordRectCounter<MapT>::StateTable::insert(const uint *ids, uint64 count)
+{
+    if (mSize >= (count > 0 ? mMaxSize : mMaxSize / 2))
+        return;                                 // full: keep the room for states that have completions
+    if (2 * (mSize + 1) > mUsed.size())
+        rehash(2 * mUsed.size());
+    uint slot = (uint)hash(ids) & mMask;
+    while (mUsed[slot])
+        slot = (slot + 1) & mMask;
+    mUsed[slot] = true;
+    mVals[slot] = count;
+    memcpy(&mKeys[slot * mKeyLength], ids, mKeyLength * sizeof(uint));
+    ++mSize;
+}
+
+template <typename MapT>
+void WordRectCounter<MapT>::StateTable::rehash(uint numSlots)
+{
+    std::vector<uint>   oldKeys;
+    std::vector<uint64> oldVals;
+    std::vector<bool>   oldUsed;
+    oldKeys.swap(mKeys);
+    oldVals.swap(mVals);
+    oldUsed.swap(mUsed);
+    mKeys.assign(numSlots * mKeyLength, 0);
+    mVals.assign(numSlots, 0);
+    mUsed.assign(numSlots, false);
+    mMask = numSlots - 1;
+    mSize = 0;
+    for (uint slot = 0; slot < oldUsed.size(); slot++) {
+        if (oldUsed[slot])
+            insert(&oldKeys[slot * mKeyLength], oldVals[slot]);
+    }
+}
@@ -0,0 +1,103 @@
+// WordRectCounter.hpp : count or uniformly sample all word rects of a short shape by dynamic programming
+
+#ifndef WordRectCounter_hpp
+#define WordRectCounter_hpp
+
+#include <map>
+#include <vector>
+
+#include "WordTrie.hpp"
+#include "TrixNode.hpp"
+#include "wordRandom.h"
+
+/**
+*   Transfer-matrix counter for word rects no more than sMaxTall rows high.
+*   Like the finders, it adds whole row words, top to bottom, but it does not keep the
+*   rows it has added.  All that matters for the rest of the rect is which column-trie
+*   node each column has reached, and indeed only what letters can still complete each
+*   column.  Columns are short, so the column trie's nodes are first merged into a few
+*   suffix-equivalence classes (as in minimizing it into a DAWG), and the state after r
+*   rows is the tuple of the columns' class IDs.  The number of ways to complete the rect
+*   from each state is memoized in a hash table, so each state is expanded only once,
+*   where the finders visit every partial rect: the last row of each state is counted
+*   once, not once per way of reaching it.  Row words are enumerated by walking the row
+*   trie's branches, trying only the letters that the column classes allow.
+*   The completion counts also allow sampling rects uniformly at random: from each state,
+*   take each next row word with probability proportional to the number of completions
+*   it leaves.
+*   The table takes at most StateTable::sMaxBytes; past that, states are counted again
+*   each time they are reached, which is still exact but slower.
+*   The counts are 64-bit and do not check for overflow, which needs more than 10^19 rects.
+*/
+template <typename MapT>
+class WordRectCounter
+{
+public:
+    static const int    sMaxTall = 4;
+
+    WordRectCounter(WordTrie<MapT, RectNode> *wordTries[], int wide, int tall);
+    WordRectCounter(const WordRectCounter&);              // Prevent pass-by-value by not defining this copy constructor.
+    WordRectCounter& operator=(const WordRectCounter&);   // Prevent assignment by not defining this operator.
+    ~WordRectCounter() { }
+
+    /** Number of wide x tall word rects.  The first call does the work. */
+    uint64              count();
+
+    /** Pick one rect uniformly at random; its row words go in rowWords[0 .. tall-1].  False if there are none. */
+    bool                sample(WordRandom& random, const char *rowWords[]);
+
+    inline uint         getNumClasses()     const   { return mNumClasses; }
+    inline uint         getNumStates()      const   { return mStates.size(); }
+
+private:
+    static const uint   sNone = ~0u;        // no such class
+
+    /** Open-addressing hash map from a state (the columns' class IDs) to its number of completions */
+    class StateTable
+    {
+    public:
+        static const uint64 sMaxBytes = 1ULL << 30;
+
+        StateTable(uint keyLength);
+        const uint64      * find(const uint *ids)   const;
+        void                insert(const uint *ids, uint64 count);
+        inline uint         size()                  const   { return mSize; }
+    private:
+        uint64              hash(const uint *ids)   const;
+        void                rehash(uint numSlots);
+        const uint          mKeyLength;     // class IDs per state: one per column
+        uint                mMaxSize;       // most states that fit in sMaxBytes
+        std::vector<uint>   mKeys;
+        std::vector<uint64> mVals;
+        std::vector<bool>   mUsed;
+        uint                mMask;
+        uint                mSize;
+    };
+
+    uint                classify(const RectNode *node);
+    uint64              countFrom(const uint *ids, int haveTall);
+    uint64              addRows(const RectNode *rowNode, int col, const uint *ids, uint *nextIds, int haveTall);
+    bool                pickRow(const RectNode *rowNode, int col, const uint *ids, uint *nextIds, int haveTall, uint64& target, const char *&rowWord);
+    inline uint         letterIndex(const RectNode *node) const { return mColTrie.charIndex(node->getLetterAt(node->getDepth() - 1)) - mBegIdx; }
+
+    const WordTrie<MapT, RectNode> &mRowTrie;
+    const WordTrie<MapT, RectNode> &mColTrie;
+    const int           mWantWide;
+    const int           mWantTall;
+    const uint          mBegIdx;
+    const uint          mNumIdx;
+    uint                mNumClasses;
+    uint                mRootClass;
+    uint                mLeafClass;
+    std::vector<uint>   mNext;              // mNext[id*mNumIdx + index] is the class after adding that letter, or sNone
+    std::vector<uint>   mBranchBeg;         // class id's allowed letters are mBranchIdx[mBranchBeg[id] .. mBranchBeg[id+1]-1]
+    std::vector<uint>   mBranchIdx;         // char index of an allowed letter
+    std::vector<uint>   mBranchNext;        // class after adding that letter
+    std::map<std::vector<uint>, uint> mSignatures;  // interns the classes while classifying
+    std::vector<uint>   mNextIds;           // the next state being built below each row, wide IDs per row
+    StateTable          mStates;
+    bool                mCounted;
+    uint64              mCount;
+};
+
+#endif // WordRectCounter_hpp
@@ -0,0 +1,127 @@
+// WordRectEstimator.cpp : estimate the size of the word rect search tree for one shape
+
+#include <math.h>
+
+#include "WordRectEstimator.hpp"
+
+template <typename MapT>
+void WordRectEstimator<MapT>::estimate(uint numProbes, Estimate& est)
+{
+    if (numProbes < 2)
+        numProbes = 2;
+    this->initRowsAndCols();
+
+    double sumNodes = 0.0, sumNodes2 = 0.0, sumWork = 0.0, sumWork2 = 0.0, sumRects = 0.0;
+    est.mMaxDepth = 0;
+    mNumChecks = 0;
+    clock_t clockBeg = clock();
+    for (uint j = 0; j < numProbes; j++) {
+        double work = 0.0, rects = 0.0;
+        int depth = 0;
+        double nodes = probe(work, rects, depth);
+        sumNodes  += nodes;
+        sumNodes2 += nodes * nodes;
+        sumWork   += work;
+        sumWork2  += work * work;
+        sumRects  += rects;
+        if (est.mMaxDepth < depth)
+            est.mMaxDepth = depth;
+    }
+    double seconds = (double)(clock() - clockBeg) / CLOCKS_PER_SEC;
+
+    double nodesMean, nodesHalf, workMean, workHalf;
+    meanAndHalfWidth(sumNodes, sumNodes2, numProbes, nodesMean, nodesHalf);
+    meanAndHalfWidth(sumWork,  sumWork2,  numProbes, workMean,  workHalf);
+    est.mNumProbes       = numProbes;
+    est.mNodes           = nodesMean;
+    est.mNodesLo         = nodesMean - nodesHalf > 1.0 ? nodesMean - nodesHalf : 1.0;
+    est.mNodesHi         = nodesMean + nodesHalf;
+    est.mRects           = sumRects / numProbes;
+    est.mSecondsPerCheck = seconds / (mNumChecks > 0 ? mNumChecks : 1);
+    est.mSeconds         =  workMean * est.mSecondsPerCheck;
+    est.mSecondsLo       = (workMean - workHalf > 0.0 ? workMean - workHalf : 0.0) * est.mSecondsPerCheck;
+    est.mSecondsHi       = (workMean + workHalf) * est.mSecondsPerCheck;
+}
+
+/** Sample mean and half-width of its 95% confidence interval (normal approximation) */
+template <typename MapT>
+void WordRectEstimator<MapT>::meanAndHalfWidth(double sum, double sumSquares, uint num, double& mean, double& halfWidth)
+{
+    mean = sum / num;
+    double variance = (sumSquares - num * mean * mean) / (num - 1);
+    halfWidth = 1.96 * sqrt(variance > 0.0 ? variance / num : 0.0);
+}
+
+/** 
+* One random root-to-leaf path: returns its estimate of the number of nodes,
+* and sets its estimates of the letters checked and the complete rects.
+*/
+template <typename MapT>
+double WordRectEstimator<MapT>::probe(double& work, double& rects, int& depth)
+{
+    double weight = 1.0, nodes = 1.0;
+    for (depth = 0; depth < this->mWantTall; depth++) {
+        uint64 checksBefore = mNumChecks;
+        uint degree = countRowsAndPickOne(depth);
+        work += weight * (double)(mNumChecks - checksBefore);
+        if (degree == 0)
+            return nodes;
+        weight *= degree;
+        nodes  += weight;
+    }
+    rects = weight;
+    return nodes;
+}
+
+/**
+* Count the row words that fit on top of the rows we have, as findWordRowsUsingTrieLinks
+* would find them, and pick one of them uniformly at random (reservoir sampling).
+* Returns the count; if it is not 0, the picked row and its column nodes are in place.
+*/
+template <typename MapT>
+uint WordRectEstimator<MapT>::countRowsAndPickOne(int haveTall)
+{
+    int prevTall = haveTall - 1;              // prevTall == -1 is ok.
+    const RectNode *rowWordNode = NULL;
+    if (haveTall == 0) {
+        rowWordNode = this->mRowTrie.getFirstWordNode();
+    } else {
+        uchr letter = this->mColFront[prevTall][0]->getLetterAt(haveTall);
+        rowWordNode = this->mRowTrie.getFirstWordNodeFromIndex(this->rowCharIndex(letter));
+    }
+
+    const RectNode **rowNodes = this->mRowNodes[haveTall];
+    const char *picked = NULL;
+    uint count = 0;
+    for (int k = 0; rowWordNode != NULL; ) {
+        const char *word = rowWordNode->getStem();
+        for (;;) {
+            ++mNumChecks;
+            uint index  = this->rowCharIndex(word[k]);
+            rowNodes[k] = rowNodes[k-1]->getBranchAtIndex(index);
+            if (this->mColFront[prevTall][k]->getBranchAtIndex(index) == NULL) {
+                break;
+            }
+            if (k == this->mWantWideM1) {
+                if (mRandom.below(++count) == 0)
+                    picked = word;
+                break;
+            }
+            k++;
+        }
+        const RectNode * nextStem = rowNodes[k]->getNextStemNode();
+        if (nextStem == NULL) {
+            break;
+        }
+        k = nextStem->getDepth() - 1;
+        rowWordNode = nextStem->getFirstWordNode();
+    }
+
+    if (picked != NULL) {
+        this->mRowWordsNow[haveTall] = picked;
+        for (int col = 0; col < this->mWantWide; col++) {
+            this->mColFront[haveTall][col] = this->mColFront[prevTall][col]->getBranchAtIndex(this->rowCharIndex(picked[col]));
+        }
+    }
+    return count;
+}
@@ -0,0 +1,64 @@
+// WordRectEstimator.hpp : estimate the size of the word rect search tree for one shape
+
+#ifndef WordRectEstimator_hpp
+#define WordRectEstimator_hpp
+
+#include "WordRectFinder.hpp"
+#include "wordRandom.h"
+
+/**
+*   Knuth's random-probe estimator ("Estimating the efficiency of backtrack programs",
+*   1975), applied to the word rect search tree of one shape.  Each probe walks from
+*   the root down one random path, choosing uniformly among the row words that fit all
+*   the column stems, exactly as findWordRowsUsingTrieLinks would enumerate them.
+*   If the degrees along the path are d1, d2, ..., then 1 + d1 + d1*d2 + ... is an
+*   unbiased estimate of the number of nodes (partial rects) that the exhaustive search
+*   visits, and the full product, for a path that reaches the full height, estimates
+*   the number of complete rects.  The estimates are heavy-tailed, so the confidence
+*   interval is only a rough guide unless the number of probes is large.
+*   The same method estimates the total work, counted as letters checked, which does
+*   vary a lot by depth; the time per letter checked, measured while probing, then
+*   converts that to seconds.  Probes jump all over the tries, where the search walks
+*   them in order, so the seconds tend to come out high, by a small factor (about 3x
+*   for 10 x 3 on a 47K-word list).
+*/
+template <typename MapT>
+class WordRectEstimator : public WordRectFinder<MapT>
+{
+public:
+    struct Estimate
+    {
+        uint            mNumProbes;
+        double          mNodes;             // mean estimated number of search nodes
+        double          mNodesLo;           // 95% confidence interval, from the normal approximation
+        double          mNodesHi;
+        double          mRects;             // mean estimated number of complete rects
+        double          mSecondsPerCheck;   // time per letter checked, measured while probing
+        double          mSeconds;           // estimated letters checked * mSecondsPerCheck
+        double          mSecondsLo;
+        double          mSecondsHi;
+        int             mMaxDepth;          // most rows reached by any probe
+    };
+
+    WordRectEstimator(WordTrie<MapT, RectNode> *wordTries[], int wide, int tall, uint64 seed)
+        : WordRectFinder<MapT>(wordTries, NULL, wide, tall, 1, 0)
+        , mRandom(seed), mNumChecks(0)
+    { }
+
+    WordRectEstimator(const WordRectEstimator&);              // Prevent pass-by-value by not defining this copy constructor.
+    WordRectEstimator& operator=(const WordRectEstimator&);   // Prevent assignment by not defining this operator.
+    virtual ~WordRectEstimator() { }
+
+    /** Run numProbes probes (at least 2) and fill in the estimate.  Does not search. */
+    void estimate(uint numProbes, Estimate& est);
+
+private:
+    double       probe(double& work, double& rects, int& depth);
+    uint         countRowsAndPickOne(int haveTall);
+    static void  meanAndHalfWidth(double sum, double sumSquares, uint num, double& mean, double& halfWidth);
+
+    WordRandom          mRandom;
+    uint64              mNumChecks;         // letters checked by countRowsAndPickOne
+};
+
+#endif // WordRectEstimator_hpp
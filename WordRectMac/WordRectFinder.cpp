@@ -7,22 +7,27 @@
 #include "WordRectSearchMgr.hpp"
 
 template <typename MapT> 
-WordRectFinder<MapT>::WordRectFinder(WordTrie<MapT, TrixNode> *wordTries[], const WordMap *maps, int wide, int tall, uint numToFind, uint options) 
+WordRectFinder<MapT>::WordRectFinder(WordTrie<MapT, RectNode> *wordTries[], const WordArray *arrays, int wide, int tall, uint numToFind, uint options) 
     : mRowTrie(*wordTries[wide])
     , mColTrie(*wordTries[tall])
-    , mWordMaps(maps)
+    , mWordArrays(arrays)
     , mWantWide(wide)
     , mWantTall(tall)
     , mNumToFind(numToFind)
     , mNumFound(0)
     , mWantWideM1(wide - 1)
     , mWantArea(wide * tall)
-    , mUseMaps(options & WordRectSearchExec::eUseMaps ? true : false)
+    , mUseArrays(options & WordRectSearchExec::eUseArrays ? true : false)
     , mUseAltA(options & WordRectSearchExec::eUseAltAlg ? true : false)
     , mMaxTall(0), mNowTall(0), mNumSymSquares(0)
     , mIsLastRectSymSquare(false), mRowWordsOld(NULL)
-    , mStartTime(-1), mState(eReady), mRowWordsNow(NULL)   
-    // start time < 0 means never; maps used as an option
+    , mStartTime(-1), mState(eReady), mRowWordsNow(NULL), mRowWordsDeep(NULL)
+    , mDeadline(0), mNumNodes(0), mSearchSeconds(0.0)
+    , mCountOnly(false), mNumCounted(0), mNumSymCounted(0)
+    , mCountFirstWord(NULL), mCountFirstWordNum(0)
+    , mOwnedRowTrie(NULL), mOwnedColTrie(NULL), mFrontier(NULL)
+    , mOrientation(eTopRowFirst), mRectTries(NULL)
+    // start time < 0 means never; word arrays used as an option
 { }
 
 template <typename MapT> 
@@ -33,8 +38,9 @@ void WordRectFinder<MapT>::initRowsAndCols()
 
     mRowWordsNow = (const char **)		new char*[mWantTall];
     mRowWordsOld = (const char **)		new char*[mWantTall];
-    mRowNodes    = (const TrixNode ***) new TrixNode**[mWantTall];
-    mColNodes    = (const TrixNode ***) new TrixNode**[mWantWide];
+    mRowWordsDeep = (const char **)		new char*[mWantTall];
+    mRowNodes    = (const RectNode ***) new RectNode**[mWantTall];
+    mColFrontRows = (const RectNode ***) new RectNode**[mWantTall + 1];
 
     // For each row, make rowNodes[row] point to the start of the word row,
     // which is one pointer address *after* the row's raw memory start, 
@@ -42,19 +48,23 @@ void WordRectFinder<MapT>::initRowsAndCols()
     // offset allows word-node indexing to agree with word-character indexing.
     int wideP1 = mWantWide + 1;
     int tallP1 = mWantTall + 1;
-    mRowNodesMem = (const TrixNode  **) new TrixNode*[wideP1 * mWantTall];
+    mRowNodesMem = (const RectNode  **) new RectNode*[wideP1 * mWantTall];
     for (int row = 0; row < mWantTall; row++) {
         mRowNodes[row]     = &mRowNodesMem[row * wideP1 + 1];
         mRowNodes[row][-1] =  mRowTrie.getRoot();
     }
 
-    // For each column, make colNodes[col] point to the start of the column,
-    // which is one pointer address *after* the column's raw memory start, 
-    // and make colNodes[col][-1] point to the mColTrie root.
-    mColNodesMem = (const TrixNode  **) new TrixNode*[mWantWide * tallP1];
+    // The column frontier is row-major: colFront[row] holds the column nodes of all
+    // the columns after that row, side by side, so that each row step reads and writes
+    // one contiguous run of pointers instead of one cache line per column.
+    // colFront[-1] is the row of column roots, so colFront is one row *after* its raw start.
+    mColFrontMem = (const RectNode  **) new RectNode*[mWantWide * tallP1];
+    for (int row = -1; row < mWantTall; row++) {
+        mColFrontRows[row + 1] = &mColFrontMem[(row + 1) * mWantWide];
+    }
+    mColFront = mColFrontRows + 1;
     for (int col = 0; col < mWantWide; col++) {
-        mColNodes[col]     = &mColNodesMem[col * tallP1 + 1];
-        mColNodes[col][-1] = mColTrie.getRoot();
+        mColFront[-1][col] = mColTrie.getRoot();
     }
 }
 
@@ -64,14 +74,56 @@ void WordRectFinder<MapT>::initRowsAndCols()
 template <typename MapT> 
 int WordRectFinder<MapT>::findWordRows()
 {
-    if (mUseMaps && mWordMaps != NULL) {
-        char  wordCols[sBufSize][sBufSize];
-        const WordMap & rowMap = mWordMaps[ getWide() ];
-        return findWordRectRowsMapUpper(0, rowMap, wordCols);
+    if (mUseArrays && mWordArrays != NULL) {
+        // Row -1 of the column runs is all the column words, for every column.
+        mColRuns.assign((mWantTall + 1) * mWantWide * 2, 0);
+        for (int col = 0; col < mWantWide; col++)
+            mColRuns[col * 2 + 1] = mWordArrays[mWantTall].size();
+        return findWordRowsUsingArrays(0);
     }
+    if (mFrontier != NULL)
+        return findWordRowsFromFrontier();
     return findWordRowsUsingTrieLinks(0);
 }
 
+/**
+* Same search, but start below each block of the frontier's rows instead of from row 0.
+* The frontier's blocks fit the columns of words of several heights, so walk each one
+* through this finder's own tries, and skip it if its rows or columns leave them.
+* What is left is exactly the set of blocks findWordRowsUsingTrieLinks would reach at
+* that depth, in the same order.
+*/
+template <typename MapT>
+int WordRectFinder<MapT>::findWordRowsFromFrontier()
+{
+    const int depth = mFrontier->getDepth();
+    const uint numBlocks = mFrontier->getNumBlocks();
+    for (uint j = 0; j < numBlocks; j++) {
+        const char * const *rows = mFrontier->getBlock(j);
+        bool fits = true;
+        for (int row = 0; fits && row < depth; row++) {
+            const char *word = rows[row];
+            for (int col = 0; col < mWantWide; col++) {
+                uint index = rowCharIndex(word[col]);
+                mRowNodes[row][col] = mRowNodes[row][col-1]->getBranchAtIndex(index);
+                mColFront[row][col] = mColFront[row-1][col]->getBranchAtIndex(index);
+                if (mRowNodes[row][col] == NULL || mColFront[row][col] == NULL) {
+                    fits = false;
+                    break;
+                }
+            }
+            mRowWordsNow[row] = word;
+        }
+        if (fits) {
+            int area = findWordRowsUsingTrieLinks(depth);
+            if (area < 0 || (area > 0 && mNumFound == mNumToFind)) {
+                return area;
+            }
+        }
+    }
+    return 0;
+}
+
 template <typename MapT> 
 int WordRectFinder<MapT>::findWordRowsUsingTrieLinks(int haveTall)
 {
@@ -80,34 +132,28 @@ int WordRectFinder<MapT>::findWordRowsUsingTrieLinks(int haveTall)
         mState = eAborted;
         return -mWantArea;  // Abort because a wordRect bigger than wantArea has been found
     }
+    if (isPastDeadline()) {
+        mState = eTimedOut;
+        return -mWantArea;  // Abort because this finder's time is up
+    }
 
     int prevTall = haveTall - 1;              // prevTall == -1 is ok.
-    const TrixNode *rowWordNode = NULL;
+    const RectNode *rowWordNode = NULL;
     if (haveTall == 0) {
         rowWordNode = mRowTrie.getFirstWordNode();
     } else if (haveTall < mWantTall) {
-        uchr letter = mColNodes[0][prevTall]->getLetterAt(haveTall);
+        uchr letter = mColFront[prevTall][0]->getLetterAt(haveTall);
         assert(mRowTrie.charMap().sourceMinChar() <= letter && letter <= mRowTrie.charMap().sourceMaxChar());
         uint index = rowCharIndex(letter);
         rowWordNode = mRowTrie.getFirstWordNodeFromIndex(index);
         if (mMaxTall < haveTall)
-            mMaxTall = haveTall;
+            recordDeeperRows(haveTall);
     } else {
         // Success: the row just added made words of all columns.
-        // Record it right now, right here.
-        mMaxTall = haveTall;
-        for (int row = 0; row < haveTall; ++row)
-            mRowWordsOld[row] = mRowWordsNow[row];
-        mIsLastRectSymSquare = isSymmetricSquare();
-        if (mIsLastRectSymSquare)
-            ++mNumSymSquares;
-        if (this->incNumFound() != getNumToFind() && WordRectSearchMgr<MapT>::getVerbosity() > 1) {
-            WordRectPrinter::printRect(this);
-        }
-        return mWantArea;                   // Return the area
+        return recordFoundRect(haveTall);
     }
 
-    const TrixNode **rowNodes = mRowNodes[haveTall];
+    const RectNode **rowNodes = mRowNodes[haveTall];
     for (int k = 0; rowWordNode != NULL; ) {
         const char *word = rowWordNode->getStem();  // Not getWord(), because we already know that rowWordNode is a word-node
         // For each vertical stem (partial column) that would result from adding this word
@@ -118,11 +164,11 @@ int WordRectFinder<MapT>::findWordRowsUsingTrieLinks(int haveTall)
             uchr letter = word[k];
             uint index  = rowCharIndex(letter);
             rowNodes[k] = rowNodes[k-1]->getBranchAtIndex(index);
-            const TrixNode *colBranch = mColNodes[k][prevTall]->getBranchAtIndex(index);
+            const RectNode *colBranch = mColFront[prevTall][k]->getBranchAtIndex(index);
             if (colBranch == NULL) {
                 break;                              // ...if not, break to get the next word.
             }
-            mColNodes[k][haveTall] = colBranch;		// ...if so, add the branch node and continue.
+            mColFront[haveTall][k] = colBranch;		// ...if so, add the branch node and continue.
             if (k == mWantWideM1) {
                 // At least one wantTall-length word exists to complete each column, including this row,
                 mRowWordsNow[haveTall] = word;                                 // so try adding another row.
@@ -142,7 +188,7 @@ int WordRectFinder<MapT>::findWordRowsUsingTrieLinks(int haveTall)
         // it just by following 2 links:  (failed node)->mNextStemNode->mFirstWordNode.
         // (If we weren't using the rowNodes, we'd need to find the parent of the first
         // disqualified node, as does WordTrie::getNextWordNodeAndIndex, but over all, that is slower.)
-        const TrixNode * nextStem = rowNodes[k]->getNextStemNode();
+        const RectNode * nextStem = rowNodes[k]->getNextStemNode();
         if (nextStem == NULL) {
             return 0;   // We've tried all possible word stems for the partial columns we got, so return. 
         }
@@ -153,9 +199,88 @@ int WordRectFinder<MapT>::findWordRowsUsingTrieLinks(int haveTall)
 }
 
 
+/** 
+* Success: the row just added made words of all columns.
+* Record it right now, right here, and return the area.
+*/
+template <typename MapT> 
+int WordRectFinder<MapT>::recordFoundRect(int haveTall)
+{
+    if (mCountOnly) {
+        // Just count it, and go on as if it had failed, so the search never stops early.
+        mMaxTall = haveTall;
+        ++mNumCounted;
+        if (mWantTall == mWantWide && isSymmetricSquare())
+            ++mNumSymCounted;
+        if (mRowWordsNow[0] != mCountFirstWord)
+            countFirstWord(mRowWordsNow[0]);
+        ++mCountFirstWordNum;
+        return 0;
+    }
+    mMaxTall = haveTall;
+    for (int row = 0; row < haveTall; ++row)
+        mRowWordsOld[row] = mRowWordsNow[row];
+    mIsLastRectSymSquare = isSymmetricSquare();
+    if (mIsLastRectSymSquare)
+        ++mNumSymSquares;
+    if (this->incNumFound() != getNumToFind() && WordRectSearchMgr<MapT>::getVerbosity() > 1) {
+        WordRectPrinter::printRect(this);
+    }
+    return mWantArea;                   // Return the area
+}
+
+/** 
+* A new depth record: save the partial rect, so that it can still be reported 
+* if the search is stopped (anytime mode) before any complete rect is found.
+*/
+template <typename MapT> 
+void WordRectFinder<MapT>::recordDeeperRows(int haveTall)
+{
+    mMaxTall = haveTall;
+    for (int row = 0; row < haveTall; ++row)
+        mRowWordsDeep[row] = mRowWordsNow[row];
+}
+
+/**
+* Turn a complete rect found from another side back to its own orientation.  Its rows are
+* dictionary words, so rather than copy their letters, find each one in the forward trie
+* of its length and use the word there.
+*/
+template <typename MapT>
+const char ** WordRectFinder<MapT>::getRectRows(const char *wordRows[]) const
+{
+    const int rectWide = getRectWide(), rectTall = getRectTall();
+    const WordTrie<MapT, RectNode> & rowTrie = *mRectTries[rectWide];
+    mRectRows.resize(rectTall);
+    for (int row = 0; row < rectTall; row++) {
+        const RectNode *node = rowTrie.getRoot();
+        for (int col = 0; col < rectWide && node != NULL; col++) {
+            int fRow, fCol;
+            turnedCell(row, col, fRow, fCol);
+            node = node->getBranchAtIndex(rowTrie.charIndex(wordRows[fRow][fCol]));
+        }
+        assert(node != NULL && node->getWord() != NULL);
+        mRectRows[row] = node != NULL ? node->getWord() : wordRows[row];
+    }
+    return &mRectRows[0];
+}
+
+/** 
+* Counting mode: the search moved on to rects with a new first row word
+* (or finished, if firstWord is NULL), so save the count for the old one.
+*/
+template <typename MapT> 
+void WordRectFinder<MapT>::countFirstWord(const char *firstWord)
+{
+    if (mCountFirstWordNum > 0)
+        mFirstWordCounts.push_back(WordCounts::value_type(mCountFirstWord, mCountFirstWordNum));
+    mCountFirstWord = firstWord;
+    mCountFirstWordNum = 0;
+}
+
 #ifdef              findWordRectRowsUsingGetNextWordNodeAndIndex  // slower than links, faster than upper_bound; left here as a reference implementation
 int WordRectFinder::findWordRectRowsUsingGetNextWordNodeAndIndex(  int wantWide, int wantTall, int haveTall
-    , const char *wordRows[sBufSize], const TrixNode ** colNodes[sBufSize] )
+    , const char *wordRows[sBufSize], const RectNode ** colNodes[sBufSize] )
 {
     if (haveTall == wantTall) {
         return wantWide*wantTall;
@@ -163,14 +288,14 @@ int WordRectFinder::findWordRectRowsUsingGetNextWordNodeAndIndex(  int wantWide,
     HaveTall = haveTall;
 
     int k = 0, prevTall = haveTall - 1;	            // prevTall == -1 is ok.
-    const TrixNode *rowWordNode = (haveTall > 0) ?
+    const RectNode *rowWordNode = (haveTall > 0) ?
         mRowTrie.getFirstWordNodeFromLetter(colNodes[0][prevTall]->getLetterAt(haveTall)) : 
     mRowTrie.getFirstWordNode();
     while(rowWordNode != NULL) {
         const char *word = rowWordNode->getStem();  // Not getWord(), because we already know that rowWordNode is a word-node
         for ( ; k < wantWide; k++) {
             // For each resulting stem (column), is there a word of length wantTall that could complete it?
-            const TrixNode *colBranch = colNodes[k][prevTall]->getBranchAtLetter(word[k]);
+            const RectNode *colBranch = colNodes[k][prevTall]->getBranchAtLetter(word[k]);
             if (colBranch == NULL) {
                 break;                              // ...if not, break (and try the next word)
             }
@@ -195,42 +320,70 @@ int WordRectFinder::findWordRectRowsUsingGetNextWordNodeAndIndex(  int wantWide,
 }
 #endif
 
+/**
+* Same search as findWordRowsUsingTrieLinks, but over the sorted word arrays: each column
+* keeps the run of column words that start with its letters so far, and adding a row narrows
+* each run by the row's letter.  When a row word fails at column k, the next one to try is
+* the first word after all those with its first k + 1 letters, found by upper bound, and the
+* runs for the letters it shares with the word before it are not narrowed again.
+*/
 template <typename MapT> 
-int WordRectFinder<MapT>::findWordRectRowsMapUpper(int haveTall, const WordMap& rowMap, char wordCols[][sBufSize])
+int WordRectFinder<MapT>::findWordRowsUsingArrays(int haveTall)
 {
-    mNowTall     = haveTall;                // rectangle height == stack height
-    int wantWide = mRowTrie.getWordLength();
-    int wantTall = mColTrie.getWordLength();
-    if (wantTall == haveTall) {            // Success: the row just added made words of all columns   
-        return mWantArea;                   // Return the area
-    }
-    if (haveTall > 2 && mWantArea <= WordRectSearchMgr<MapT>::getTrumpingArea()) {
-        return -mWantArea;                  // Abort because a wordRect bigger than wantArea has been found
-    }
-
-    char temp[sBufSize];
-
-    int area = 0;
-    for(WordMap::const_iterator itr = rowMap.begin(), end = rowMap.end(); itr != end; ) {
-        const char *word = itr->first;
-        for (int k = 0; k < wantWide; k++) {
-            wordCols[k][haveTall] = temp[k] = word[k];
-            if ( ! mColTrie.subTrix(wordCols[k], haveTall) ) {
-                temp[k+1] = '{';				// ASCII decimal 123, the char after 'z'
-                temp[k+2] = '\0';				// NULL-terminate the C-string
-                itr = rowMap.upper_bound(temp);	// Get first word-node alphabetically > temp
-                goto END_LOOP;          		// break out of both inner and outer loop
-            }
+    mNowTall = haveTall;
+    if (haveTall > 1 && mWantArea <= WordRectSearchMgr<MapT>::getTrumpingArea()) {
+        mState = eAborted;
+        return -mWantArea;  // Abort because a wordRect bigger than wantArea has been found
+    }
+    if (isPastDeadline()) {
+        mState = eTimedOut;
+        return -mWantArea;  // Abort because this finder's time is up
+    }
+    if (haveTall == mWantTall) {
+        return recordFoundRect(haveTall);   // Success: the row just added made words of all columns.
+    }
+
+    const WordArray& rowWords = mWordArrays[mWantWide];
+    const WordArray& colWords = mWordArrays[mWantTall];
+    const uint *prevRuns = &mColRuns[haveTall * mWantWide * 2];     // row haveTall - 1
+    uint       *nextRuns = &mColRuns[(haveTall + 1) * mWantWide * 2];
+    uint idx = 0;
+    if (haveTall > 0) {
+        // The first column's words start no earlier than its first word's next letter.
+        idx = rowWords.lowerBound(colWords.getWord(prevRuns[0]) + haveTall, 1);
+        if (mMaxTall < haveTall)
+            recordDeeperRows(haveTall);
+    }
+    const char *prevWord = NULL;
+    for (const uint numWords = rowWords.size(); idx < numWords; ) {
+        // The columns under the letters this word shares with the last one are already narrowed.
+        const char *word = rowWords.getWord(idx);
+        int k = 0;
+        if (prevWord != NULL) {
+            while (word[k] == prevWord[k])
+                k++;
+        }
+        for ( ; k < mWantWide; k++) {
+            uint beg = prevRuns[k * 2], end = prevRuns[k * 2 + 1];
+            colWords.narrow(beg, end, haveTall, word[k]);
+            if (beg == end)
+                break;
+            nextRuns[k * 2]     = beg;
+            nextRuns[k * 2 + 1] = end;
+        }
+        prevWord = word;
+        if (k < mWantWide) {
+            idx = rowWords.upperBound(word, k + 1);     // Skip every word that would fail at column k, too.
+            continue;
         }
         mRowWordsNow[haveTall] = word;
-        area = findWordRectRowsMapUpper(haveTall+1, rowMap, wordCols);
-        if (area > 0) {
+        int area = findWordRowsUsingArrays(haveTall + 1);
+        if (area < 0 || (area > 0 && mNumFound == mNumToFind)) {
             return area;
         }
-        ++itr;
-END_LOOP:;
+        ++idx;
     }
-    return 0;
+    return 0;   // Failure: No wantWide x wantTall word rect at the end of this path
 }
 
 /*
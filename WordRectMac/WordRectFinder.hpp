@@ -4,20 +4,33 @@
 #ifndef WordRectFinder_hpp
 #define WordRectFinder_hpp
 
-#include <map>
+#include <ctime>
+#include <vector>
 
+#include "CodePointMap.hpp"
+#include "WordArray.hpp"
 #include "WordTrie.hpp"
 #include "TrixNode.hpp"
 
+template <typename MapT> class WordRectFrontier;
 
-struct ltstr
-{
-    inline bool operator()(const char* s1, const char* s2) const
-    {
-        return strcmp(s1, s2) < 0;
-    }
-};
-typedef std::map<const char*, int, ltstr> WordMap;
+typedef std::vector< std::pair<const char*, uint64> > WordCounts;   // e.g., number of rects per first row word
+
+/**
+*   Which side of a rect a finder fills first.  A finder always fills its own rows from the
+*   top down, so to fill a rect from another side, it searches a turned rect instead: the
+*   rect turned upside down (rows last to first, each read backwards, so from the reversed
+*   tries), or transposed (rows and columns swapped), or both.  Each complete rect it finds
+*   is turned back to be shown or recorded.  eBestSideFirst means pick a side for each shape.
+*/
+typedef enum {
+    eTopRowFirst    = 0,
+    eBottomRowFirst = 1,    // upside down: the reversed tries, same shape
+    eLeftColFirst   = 2,    // transposed: the forward tries, wide and tall swapped
+    eRightColFirst  = 3,    // both
+    eNumSides       = 4,
+    eBestSideFirst  = 4,
+} RectOrientation;
 
 /**
 *
@@ -37,6 +50,7 @@ public:
     typedef int (WordRectFinder::*rowFinderFn)(int);
 
     static const int sBufSize = 64;
+    static const uint sTimeCheckMask = 0xFFF;  // check the clock once every 4096 nodes
 
     // Define individual finder states.
     typedef enum { 
@@ -45,20 +59,25 @@ public:
         ePaused     = 3,
         eAborted    = 4,
         eFinished   = 5,
+        eTimedOut   = 6,
     } FinderState;
 
  
-    WordRectFinder(WordTrie<MapT, TrixNode> *wordTries[], const WordMap *maps, int wide, int tall, uint numToFind, uint options);
+    WordRectFinder(WordTrie<MapT, RectNode> *wordTries[], const WordArray *arrays, int wide, int tall, uint numToFind, uint options);
     WordRectFinder(const WordRectFinder&);             // Prevent pass-by-value by not defining copy constructor.
     WordRectFinder& operator=(const WordRectFinder&);  // Prevent assignment by not defining this operator.
     virtual ~WordRectFinder() 
     {
         if (mRowWordsNow != NULL) {
-            free(mRowWordsNow);
-            free(mRowWordsOld);
-            free(mRowNodesMem);
-            free(mColNodesMem);
+            delete [] mRowWordsNow;
+            delete [] mRowWordsOld;
+            delete [] mRowWordsDeep;
+            delete [] mRowNodesMem;
+            delete [] mColFrontRows;
+            delete [] mColFrontMem;
         }
+        delete mOwnedRowTrie;
+        delete mOwnedColTrie;
     }                         
 
     inline uint			rowCharIndex(uchr letter) const { return mRowTrie.charIndex(letter); }
@@ -73,6 +92,51 @@ public:
     inline int          getNumFound()   const   { return mNumFound; }
     inline int          incNumFound()           { return ++mNumFound; }
     inline FinderState  getState()      const   { return mState; }
+    inline int          getMaxTall()    const   { return mMaxTall; }
+    inline uint64       getNumNodes()   const   { return mNumNodes; }
+    inline double       getSearchSeconds() const{ return mSearchSeconds; }
+    inline void         setDeadline(time_t when){ mDeadline = when; }
+    inline time_t       getDeadline()   const   { return mDeadline; }
+    inline void         setCountOnly(bool count){ mCountOnly = count; }
+    inline bool         getCountOnly()  const   { return mCountOnly; }
+    inline uint64       getNumCounted() const   { return mNumCounted; }
+    inline uint64       getNumSymCounted() const{ return mNumSymCounted; }
+    inline const WordCounts& getFirstWordCounts() const { return mFirstWordCounts; }
+
+    /** Take ownership of the tries this finder was made from (see WordRectPruner), to delete them with it. */
+    inline void         adoptTries(WordTrie<MapT, RectNode> *rowTrie, WordTrie<MapT, RectNode> *colTrie)
+    {
+        mOwnedRowTrie = rowTrie;
+        mOwnedColTrie = colTrie != rowTrie ? colTrie : NULL;
+    }
+
+    /** Start from the blocks of shallow rows in frontier, instead of from the first row (see WordRectFrontier). */
+    inline void         setFrontier(const WordRectFrontier<MapT> *frontier) { mFrontier = frontier; }
+
+    /**
+    * Search this finder's shape as the turned form of a rect, filled from another side (see
+    * RectOrientation).  rectTries are the forward tries, for finding the rect's own rows.
+    */
+    inline void         setOrientation(RectOrientation orient, WordTrie<MapT, RectNode> * const rectTries[])
+    {
+        mOrientation = orient;
+        mRectTries   = rectTries;
+    }
+    inline RectOrientation getOrientation() const { return mOrientation; }
+    inline bool         isTransposed()  const   { return mOrientation == eLeftColFirst || mOrientation == eRightColFirst; }
+    inline int          getRectWide()   const   { return isTransposed() ? mWantTall : mWantWide; }
+    inline int          getRectTall()   const   { return isTransposed() ? mWantWide : mWantTall; }
+
+    /**
+    * Rows of the last complete rect found, if any, else of the deepest partial rect so far.
+    * A complete rect is turned back to its own orientation, but a partial one is left as searched.
+    */
+    inline const char ** getBestRows() const
+    {
+        if (mMaxTall < mWantTall)
+            return mRowWordsDeep;
+        return mOrientation == eTopRowFirst ? mRowWordsOld : getRectRows(mRowWordsOld);
+    }
 
     void printWordRectLastFound(time_t timeNow) const
     {
@@ -82,8 +146,8 @@ public:
             return;
         }
 
-        int wide = getWide();
-        int tall = getTall();
+        int wide = getRectWide();
+        int tall = getRectTall();
         const char *what = mIsLastRectSymSquare ? "Sym Square" : " Word Rect";
         printf("FOUND  %2d * %2d %s, area %3d in %2d seconds in thread %d (SS/WR %d / %d):\n"
             , wide, tall, what, wide*tall, (int)(timeNow - mStartTime), mId
@@ -93,19 +157,33 @@ public:
 
     virtual void printWordRectInProgress(time_t timeNow)    const
     {
-        int wantWide = getWide();
+        int wantWide = getRectWide();
         int haveTall = mNowTall;   // snapshot, because mHaveTall is prone to change between printf's
-        printf("Trying %2d * %2d & found %2d rows after %2d seconds in thread %d (SS/WR %d / %d):\n", wantWide, getTall()
+        printf("Trying %2d * %2d & found %2d rows after %2d seconds in thread %d (SS/WR %d / %d):\n", wantWide, getRectTall()
             , haveTall, (int)(timeNow - mStartTime), mId, mNumSymSquares, mNumFound);
         printWordRows(mRowWordsNow, haveTall);
     }
 
-    /** Print actual word rows of complete or in-progress word rectangle. */
+    /**
+    * Print actual word rows of complete or in-progress word rectangle.  If this finder fills
+    * the rect from another side, print it turned back, with a dot for each letter not yet found.
+    */
     virtual void printWordRows(const char *wordRows[], int haveTall) const
     {
+        if (mOrientation != eTopRowFirst) {
+            for (int row = 0; row < getRectTall(); row++) {
+                for (int col = 0; col < getRectWide(); col++) {
+                    int fRow, fCol;
+                    turnedCell(row, col, fRow, fCol);
+                    printf(" %s", fRow < haveTall ? CodePointMap::getText(wordRows[fRow][fCol]) : ".");
+                }
+                printf("\n");
+            }
+            return;
+        }
         for (int k = 0; k < haveTall; k++) {
             for (const char *pc = wordRows[k]; *pc != '\0'; pc++) {
-                printf(" %c", *pc);
+                printf(" %s", CodePointMap::getText(*pc));
             }
             printf("\n");
         }
@@ -116,7 +194,11 @@ public:
         initRowsAndCols();
         time(&mStartTime);
         mState = eSearching;
+        clock_t clockBeg = clock();
         int foundArea = findWordRows();
+        mSearchSeconds = (double)(clock() - clockBeg) / CLOCKS_PER_SEC;
+        if (mCountOnly)
+            countFirstWord(NULL);   // flush the count for the last first row word
         if (mMaxTall == mWantTall) {
             if (mState != eAborted)
                 mState  = eFinished;
@@ -131,14 +213,39 @@ protected:
 
 #ifdef         findWordRectRowsUsingGetNextWordNodeAndIndex       // obsolete, but left here as a reference implementation
     static int findWordRectRowsUsingGetNextWordNodeAndIndex(  int wantWide, int wantTall, int haveTall, WordTrie& mRowTrie, WordTrie& mColTrie
-        , const char *wordRows[sBufSize], const TrixNode ** colNodes[sBufSize] );
+        , const char *wordRows[sBufSize], const RectNode ** colNodes[sBufSize] );
 #endif
-    int  findWordRectRowsMapUpper(int haveTall, const WordMap& rowMap, char wordCols[][sBufSize]);
+    int  findWordRowsUsingArrays(int haveTall);
+    int  recordFoundRect(int haveTall);
+    void recordDeeperRows(int haveTall);
+    void countFirstWord(const char *firstWord);
+
+    /** Count one more search node, and once in a while, check the clock against any deadline. */
+    inline bool isPastDeadline()
+    {
+        return (++mNumNodes & sTimeCheckMask) == 0 && mDeadline > 0 && time(NULL) >= mDeadline;
+    }
     //virtual void printWordRows(const char *wordRows[], int haveTall)    const;
 
+    /** Where the rect's letter at (row, col) is in this finder's turned rect. */
+    inline void turnedCell(int row, int col, int& fRow, int& fCol) const
+    {
+        int lastRow = getRectTall() - 1, lastCol = getRectWide() - 1;
+        switch (mOrientation) {
+        case eBottomRowFirst:   fRow = lastRow - row;   fCol = lastCol - col;   break;
+        case eLeftColFirst:     fRow = col;             fCol = row;             break;
+        case eRightColFirst:    fRow = lastCol - col;   fCol = lastRow - row;   break;
+        default:                fRow = row;             fCol = col;             break;
+        }
+    }
+
+    /** The rows of the complete rect turned back from wordRows, as the words in mRectTries. */
+    const char ** getRectRows(const char *wordRows[]) const;
+
 private:
     virtual int  findWordRows();    
     virtual int  findWordRowsUsingTrieLinks(int haveTall); // cpp comment
+    int          findWordRowsFromFrontier();
     //virtual bool isSymmetricSquare()                const;
 
     //template <typename  T> 
@@ -146,9 +253,18 @@ private:
     {
         if (mWantTall != mWantWide)
             return false;                           // not square
+        if (mUseArrays) {                           // no nodes, so compare the letters
+            for (int row = mWantTall; --row >= 0; ) {
+                for (int col = row; --col >= 0; ) {
+                    if (mRowWordsNow[row][col] != mRowWordsNow[col][row])
+                        return false;
+                }
+            }
+            return true;
+        }
         for (int row = mWantTall; --row >= 0; ) {
             for (int col = mWantTall; --col >= 0; ) {
-                if (mRowNodes[row][col] != mColNodes[row][col])
+                if (mRowNodes[row][col] != mColFront[col][row])
                     return false;                   // not symmetric
             }
         }
@@ -156,8 +272,8 @@ private:
     }
 
 protected:
-    const WordTrie<MapT, TrixNode>  &mRowTrie;
-    const WordTrie<MapT, TrixNode>  &mColTrie;
+    const WordTrie<MapT, RectNode>  &mRowTrie;
+    const WordTrie<MapT, RectNode>  &mColTrie;
     const int           mWantWide;
     const int           mWantTall;
     const int           mWantWideM1;
@@ -166,16 +282,33 @@ protected:
     int                 mNowTall;
     int					mNumSymSquares;			// Number of symmetric squares found
     int                 mId;                    // Any unique id, but in practice, this is the thread index.
-    const bool          mUseMaps;
+    const bool          mUseArrays;
     const bool          mUseAltA;
     bool                mIsLastRectSymSquare;   // Is mLastRect a symmetric word square?
     time_t              mStartTime;             // Negative value means never started.
     FinderState         mState;
     const char        **mRowWordsOld;				// The current array of words, as rows, i.e. the partial word rect being checked.
     const char        **mRowWordsNow;				// The most recently found word rect, if any.
-    const TrixNode   ***mRowNodes, **mRowNodesMem;
-    const TrixNode   ***mColNodes, **mColNodesMem;
-    const WordMap      *mWordMaps;              // used only by findWordRectRowsMapUpper; to add more finders, consider using templates or a factory
+    const char        **mRowWordsDeep;				// The deepest partial word rect found so far (mMaxTall rows).
+    const RectNode   ***mRowNodes, **mRowNodesMem;
+    const RectNode   ***mColFront, ***mColFrontRows, **mColFrontMem;   // mColFront[row][col]: row-major column frontier, with mColFront[-1] the roots
+    const WordArray    *mWordArrays;            // used only by findWordRowsUsingArrays; to add more finders, consider using templates or a factory
+    std::vector<uint>   mColRuns;               // for findWordRowsUsingArrays: begin and end of each column's run of words, by row
+    time_t              mDeadline;              // Time to give up (anytime mode), or 0 for no time limit.
+    uint64              mNumNodes;              // Number of search nodes (partial rects) visited.
+    double              mSearchSeconds;         // Processor time taken by doSearch, for node rates.
+    bool                mCountOnly;             // Counting mode: tally all rects, but don't record, print, or stop for them.
+    uint64              mNumCounted;            // Counting mode: number of rects
+    uint64              mNumSymCounted;         // Counting mode: number of those that are symmetric squares
+    const char        * mCountFirstWord;        // Counting mode: first row word of the latest rects counted
+    uint64              mCountFirstWordNum;     // Counting mode: number of rects counted for mCountFirstWord so far
+    WordCounts          mFirstWordCounts;       // Counting mode: number of rects for each first row word, in search order
+    WordTrie<MapT, RectNode> *mOwnedRowTrie;    // Shape-specific tries to delete with this finder, if any
+    WordTrie<MapT, RectNode> *mOwnedColTrie;
+    const WordRectFrontier<MapT> *mFrontier;    // Shared blocks of shallow rows to start from, if any (not owned)
+    RectOrientation     mOrientation;           // Side of the rect that this finder's first row is (see RectOrientation)
+    WordTrie<MapT, RectNode> * const *mRectTries;   // Forward tries, to look up the rows of a turned rect
+    mutable std::vector<const char *> mRectRows;    // The rows of the last rect, turned back
 
 private:
     const int           mNumToFind;
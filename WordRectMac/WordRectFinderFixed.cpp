@@ -0,0 +1,130 @@
+// WordRectFinderFixed.cpp : word rect finder with the width fixed at compile time
+
+#include "WordRectFinderFixed.hpp"
+#include "WordRectSearchMgr.hpp"
+
+template <typename MapT, int W>
+int WordRectFinderFixed<MapT, W>::findWordRows()
+{
+    const RectNode *colRoots[W];
+    for (int col = 0; col < W; col++)
+        colRoots[col] = this->mColTrie.getRoot();
+    if (this->mFrontier != NULL)
+        return findWordRowsFromFrontier(colRoots);
+    return findWordRowsFixed(0, colRoots);
+}
+
+/** Same as WordRectFinder::findWordRowsFromFrontier, with one row of column nodes per block row. */
+template <typename MapT, int W>
+int WordRectFinderFixed<MapT, W>::findWordRowsFromFrontier(const RectNode * const colRoots[W])
+{
+    const int depth = this->mFrontier->getDepth();
+    const uint numBlocks = this->mFrontier->getNumBlocks();
+    const RectNode *colNodes[W];
+    for (uint j = 0; j < numBlocks; j++) {
+        const char * const *rows = this->mFrontier->getBlock(j);
+        bool fits = true;
+        for (int col = 0; col < W; col++)
+            colNodes[col] = colRoots[col];
+        for (int row = 0; fits && row < depth; row++) {
+            const char *word = rows[row];
+            const RectNode *rowNode = this->mRowTrie.getRoot();
+            for (int col = 0; col < W; col++) {
+                uint index = this->rowCharIndex(word[col]);
+                rowNode = rowNode->getBranchAtIndex(index);
+                colNodes[col] = colNodes[col]->getBranchAtIndex(index);
+                if (rowNode == NULL || colNodes[col] == NULL) {
+                    fits = false;
+                    break;
+                }
+            }
+            this->mRowWordsNow[row] = word;
+        }
+        if (fits) {
+            int area = findWordRowsFixed(depth, colNodes);
+            if (area < 0 || (area > 0 && this->getNumFound() == this->getNumToFind())) {
+                return area;
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+* colNodesAbove[k] is the column-trie node for the first haveTall letters of column k.
+* This frame's own colNodes[] become the row above for the next row down.
+*/
+template <typename MapT, int W>
+int WordRectFinderFixed<MapT, W>::findWordRowsFixed(int haveTall, const RectNode * const colNodesAbove[W])
+{
+    this->mNowTall = haveTall;
+    if (haveTall > 1 && this->mWantArea <= WordRectSearchMgr<MapT>::getTrumpingArea()) {
+        this->mState = WordRectFinder<MapT>::eAborted;
+        return -this->mWantArea;  // Abort because a wordRect bigger than wantArea has been found
+    }
+    if (this->isPastDeadline()) {
+        this->mState = WordRectFinder<MapT>::eTimedOut;
+        return -this->mWantArea;  // Abort because this finder's time is up
+    }
+
+    const RectNode *rowWordNode = NULL;
+    if (haveTall == 0) {
+        rowWordNode = this->mRowTrie.getFirstWordNode();
+    } else if (haveTall < this->mWantTall) {
+        uchr letter = colNodesAbove[0]->getLetterAt(haveTall);
+        rowWordNode = this->mRowTrie.getFirstWordNodeFromIndex(this->rowCharIndex(letter));
+        if (this->mMaxTall < haveTall)
+            this->recordDeeperRows(haveTall);
+    } else {
+        return this->recordFoundRect(haveTall);
+    }
+
+    const RectNode *rowNodes[W + 1];            // rowNodes[k+1] is the row-trie node for this row's first k+1 letters
+    const RectNode *colNodes[W];
+    rowNodes[0] = this->mRowTrie.getRoot();
+    for (int k = 0; rowWordNode != NULL; ) {
+        const char *word = rowWordNode->getStem();
+        for (;;) {
+            uint index = this->rowCharIndex(word[k]);
+            rowNodes[k+1] = rowNodes[k]->getBranchAtIndex(index);
+            const RectNode *colBranch = colNodesAbove[k]->getBranchAtIndex(index);
+            if (colBranch == NULL) {
+                break;
+            }
+            colNodes[k] = colBranch;
+            if (k == W - 1) {
+                this->mRowWordsNow[haveTall] = word;
+                int area = findWordRowsFixed(haveTall + 1, colNodes);
+                if (area < 0 || (area > 0 && this->getNumFound() == this->getNumToFind())) {
+                    return area;
+                }
+                break;
+            }
+            k++;
+        }
+        // Skip to the first word whose stem is past the one that failed at column k.
+        const RectNode * nextStem = rowNodes[k+1]->getNextStemNode();
+        if (nextStem == NULL) {
+            return 0;
+        }
+        k = nextStem->getDepth() - 1;
+        rowWordNode = nextStem->getFirstWordNode();
+    }
+    return 0;
+}
+
+/** The row and column nodes are not kept, so compare the letters of the rows just found. */
+template <typename MapT, int W>
+bool WordRectFinderFixed<MapT, W>::isSymmetricSquare() const
+{
+    if (this->mWantTall != W)
+        return false;                           // not square
+    const char **rows = this->mRowWordsNow;
+    for (int row = 1; row < W; row++) {
+        for (int col = 0; col < row; col++) {
+            if (rows[row][col] != rows[col][row])
+                return false;                   // not symmetric
+        }
+    }
+    return true;                                // square and symmetric
+}
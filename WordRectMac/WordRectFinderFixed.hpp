@@ -0,0 +1,39 @@
+// WordRectFinderFixed.hpp : word rect finder with the width fixed at compile time
+
+#ifndef WordRectFinderFixed_hpp
+#define WordRectFinderFixed_hpp
+
+#include "WordRectFinder.hpp"
+
+/**
+*   Same search as WordRectFinder::findWordRowsUsingTrieLinks, but with the width W
+*   a template parameter instead of the runtime fields mWantWide and mWantWideM1.
+*   Each level of the recursion keeps its own row of column nodes, a fixed-size array
+*   on the stack, and reads the row above it through a pointer, so there are no
+*   column-major tables to index, and the compiler knows every loop bound and offset.
+*   WordRectSearchMgr::newRectFinder instantiates this for widths sMinWide through
+*   sMaxWide, and falls back to the generic WordRectFinder for anything wider.
+*/
+template <typename MapT, int W>
+class WordRectFinderFixed : public WordRectFinder<MapT>
+{
+public:
+    static const int sMinWide = 2;
+    static const int sMaxWide = 16;
+
+    WordRectFinderFixed(WordTrie<MapT, RectNode> *wordTries[], const WordArray *arrays, int tall, uint numToFind, uint options)
+        : WordRectFinder<MapT>(wordTries, arrays, W, tall, numToFind, options)
+    { }
+
+    WordRectFinderFixed(const WordRectFinderFixed&);              // Prevent pass-by-value by not defining this copy constructor.
+    WordRectFinderFixed& operator=(const WordRectFinderFixed&);   // Prevent assignment by not defining this operator.
+    virtual ~WordRectFinderFixed() { }
+
+private:
+    virtual int  findWordRows();
+    int          findWordRowsFixed(int haveTall, const RectNode * const colNodesAbove[W]);
+    int          findWordRowsFromFrontier(const RectNode * const colRoots[W]);
+    virtual bool isSymmetricSquare() const;
+};
+
+#endif // WordRectFinderFixed_hpp
@@ -0,0 +1,101 @@
+// WordRectFrontier.cpp : shallow partial rects of one width, found once and shared by the finders of several heights
+
+#include <ctime>
+
+#include "WordRectFrontier.hpp"
+
+template <typename MapT>
+WordRectFrontier<MapT>::WordRectFrontier(WordTrie<MapT, RectNode> *wordTries[], int wide, int depth, int minTall, int maxTall)
+    : mRowTrie(*wordTries[wide])
+    , mStemTrie(NULL)
+    , mWantWide(wide)
+    , mDepth(depth)
+    , mComplete(true)
+    , mNumStems(0)
+    , mSeconds(0.0)
+    , mRowsNow(depth, (const char *)NULL)
+    , mColNodesMem((depth + 1) * wide, (const RectNode *)NULL)
+{
+    clock_t clockBeg = clock();
+
+    // A column can begin with any stem of a word of any of the heights, so put them all in one trie.
+    std::set<std::string> stems;
+    for (int tall = (minTall > depth ? minTall : depth + 1); tall <= maxTall; tall++)
+        addStems(wordTries[tall]->getRoot(), stems);
+    mStemTrie = new WordTrie<MapT, RectNode>(mRowTrie.charMap(), depth);
+    RectNode *prevNode = NULL;
+    for (std::set<std::string>::const_iterator it = stems.begin(); it != stems.end(); ++it)
+        prevNode = mStemTrie->insertWord(it->c_str(), prevNode);
+    mNumStems = (uint)stems.size();
+
+    for (int col = 0; col < wide; col++)
+        mColNodesMem[col] = mStemTrie->getRoot();
+    if (mNumStems > 0)
+        collect(0);
+    mSeconds = (double)(clock() - clockBeg) / CLOCKS_PER_SEC;
+}
+
+/** Add the first mDepth letters of every word below node, a node of a trie of longer words. */
+template <typename MapT>
+void WordRectFrontier<MapT>::addStems(const RectNode *node, std::set<std::string>& stems) const
+{
+    if ((int)node->getDepth() == mDepth) {
+        stems.insert(std::string(node->getStem(), mDepth));
+        return;
+    }
+    for (const RectNode *child = node->getFirstChild(); child != NULL; child = child->getNextBranch())
+        addStems(child, stems);
+}
+
+/**
+* Same walk through the row trie as WordRectFinder::findWordRowsUsingTrieLinks, with the
+* stem trie for the columns, but it stops at mDepth rows and keeps each block it reaches.
+*/
+template <typename MapT>
+void WordRectFrontier<MapT>::collect(int haveTall)
+{
+    if (haveTall == mDepth) {
+        if (mRows.size() >= (size_t)sMaxBlocks * mDepth) {
+            mComplete = false;
+            return;
+        }
+        mRows.insert(mRows.end(), mRowsNow.begin(), mRowsNow.end());
+        return;
+    }
+    const RectNode **colNodesAbove = &mColNodesMem[haveTall * mWantWide];
+    const RectNode **colNodes      = &mColNodesMem[(haveTall + 1) * mWantWide];
+    const RectNode *rowWordNode = NULL;
+    if (haveTall == 0) {
+        rowWordNode = mRowTrie.getFirstWordNode();
+    } else {
+        uchr letter = colNodesAbove[0]->getLetterAt(haveTall);
+        rowWordNode = mRowTrie.getFirstWordNodeFromIndex(mRowTrie.charIndex(letter));
+    }
+
+    std::vector<const RectNode *> rowNodes(mWantWide + 1);
+    rowNodes[0] = mRowTrie.getRoot();
+    for (int k = 0; rowWordNode != NULL && mComplete; ) {
+        const char *word = rowWordNode->getStem();
+        for (;;) {
+            uint index = mRowTrie.charIndex(word[k]);
+            rowNodes[k+1] = rowNodes[k]->getBranchAtIndex(index);
+            const RectNode *colBranch = colNodesAbove[k]->getBranchAtIndex(index);
+            if (colBranch == NULL) {
+                break;
+            }
+            colNodes[k] = colBranch;
+            if (k == mWantWide - 1) {
+                mRowsNow[haveTall] = word;
+                collect(haveTall + 1);
+                break;
+            }
+            k++;
+        }
+        const RectNode * nextStem = rowNodes[k+1]->getNextStemNode();
+        if (nextStem == NULL) {
+            return;
+        }
+        k = nextStem->getDepth() - 1;
+        rowWordNode = nextStem->getFirstWordNode();
+    }
+}
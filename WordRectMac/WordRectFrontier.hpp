@@ -0,0 +1,65 @@
+// WordRectFrontier.hpp : shallow partial rects of one width, found once and shared by the finders of several heights
+
+#ifndef WordRectFrontier_hpp
+#define WordRectFrontier_hpp
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "WordTrie.hpp"
+#include "TrixNode.hpp"
+
+/**
+*   The finders for wide x tall and wide x (tall+1) search with the same row trie, but each
+*   starts over from the first row, so the shallow rows they have in common get searched
+*   again for every height.  A frontier does the first few rows (its depth) just once for
+*   all the heights in range: it collects every wide x depth block of row words whose
+*   columns begin some column word of any of those heights.  That is a superset of the
+*   partial rects that any one height's search reaches at that depth, so a finder can
+*   start from the frontier instead of its own shallow rows, dropping the blocks whose
+*   columns do not begin words of its own height, and lose nothing (see
+*   WordRectFinder::findWordRowsFromFrontier).  The blocks come out in the same order
+*   as the finders would search them.
+*   A frontier is read-only once built, so finders in several threads can share it.
+*   It gives up, and is not used, if it would hold more than sMaxBlocks blocks.
+*/
+template <typename MapT>
+class WordRectFrontier
+{
+public:
+    static const uint   sMaxBlocks = 1 << 20;
+
+    /** Collect the blocks of depth rows that can start a rect of any height in minTall to maxTall, all deeper than depth. */
+    WordRectFrontier(WordTrie<MapT, RectNode> *wordTries[], int wide, int depth, int minTall, int maxTall);
+    WordRectFrontier(const WordRectFrontier&);              // Prevent pass-by-value by not defining this copy constructor.
+    WordRectFrontier& operator=(const WordRectFrontier&);   // Prevent assignment by not defining this operator.
+    ~WordRectFrontier() { delete mStemTrie; }
+
+    inline int          getWide()               const   { return mWantWide; }
+    inline int          getDepth()              const   { return mDepth; }
+    inline bool         isComplete()            const   { return mComplete; }
+    inline uint         getNumBlocks()          const   { return (uint)(mRows.size() / mDepth); }
+    inline uint         getNumStems()           const   { return mNumStems; }
+    inline double       getSeconds()            const   { return mSeconds; }
+
+    /** The depth row words of block j. */
+    inline const char * const * getBlock(uint j) const  { return &mRows[j * mDepth]; }
+
+private:
+    void                collect(int haveTall);
+    void                addStems(const RectNode *node, std::set<std::string>& stems) const;
+
+    const WordTrie<MapT, RectNode> &mRowTrie;
+    WordTrie<MapT, RectNode> *mStemTrie;        // the depth-letter stems of all the column words of the heights served
+    const int           mWantWide;
+    const int           mDepth;
+    bool                mComplete;
+    uint                mNumStems;
+    double              mSeconds;
+    std::vector<const char *> mRows;            // mDepth row words per block, block after block
+    std::vector<const char *> mRowsNow;         // the block being built
+    std::vector<const RectNode *> mColNodesMem; // stem-trie nodes of the columns after each row, with the roots first
+};
+
+#endif // WordRectFrontier_hpp
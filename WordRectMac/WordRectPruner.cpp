@@ -0,0 +1,149 @@
+// WordRectPruner.cpp : shape-specific tries of only the words that can fit a word rect's rows or columns
+
+#include "WordRectPruner.hpp"
+
+template <typename MapT>
+WordRectPruner<MapT>::WordRectPruner(WordTrie<MapT, RectNode> *wordTries[], uint maxWordLength, int wide, int tall)
+    : mTries(wordTries, wordTries + maxWordLength + 1)
+    , mRowTrie(NULL), mColTrie(NULL)
+    , mNumRowWords(0), mNumColWords(0)
+    , mRowNodes(0), mBaseRowNodes(wordTries[wide]->mTotalNodes)
+    , mNumPasses(0), mSeconds(0.0)
+{
+    clock_t clockBeg = clock();
+    listWords(wordTries[wide], mRowWords);
+    listWords(wordTries[tall], mColWords);
+    mNumRowWords = (uint)mRowWords.size();
+    mNumColWords = (uint)mColWords.size();
+    mRowNodes = mBaseRowNodes;
+    if (wide > sMaxPlaces || tall > sMaxPlaces)
+        return;                                 // too big to keep the places in a bit mask, so leave the tries as they are
+
+    // Each word starts out allowed in every place: rows in any row, columns in any column.
+    std::vector<uint64> rowPlaces(mRowWords.size(), (~0ULL) >> (sMaxPlaces - tall));
+    std::vector<uint64> colPlaces(mColWords.size(), (~0ULL) >> (sMaxPlaces - wide));
+    std::vector<bool>   rowLetters, colLetters, cells;
+    for (uint changed = 1; changed > 0; ) {
+        ++mNumPasses;
+        findLetters(mRowWords, rowPlaces, wide, tall, rowLetters);
+        findLetters(mColWords, colPlaces, tall, wide, colLetters);
+        // A cell can hold a letter only if some row word and some column word can put it there.
+        cells.assign(tall * wide * sNumChars, false);
+        for (int row = 0; row < tall; row++) {
+            for (int col = 0; col < wide; col++) {
+                for (uint letter = 0; letter < sNumChars; letter++) {
+                    cells[(row * wide + col) * sNumChars + letter] = rowLetters[(row * wide + col) * sNumChars + letter]
+                                                                  && colLetters[(col * tall + row) * sNumChars + letter];
+                }
+            }
+        }
+        changed  = prunePlaces(mRowWords, rowPlaces, wide, tall, cells, wide * sNumChars, sNumChars);
+        changed += prunePlaces(mColWords, colPlaces, tall, wide, cells, sNumChars, wide * sNumChars);
+    }
+
+    // For squares, rows and columns come from the same trie, so keep the words that fit either way.
+    // (They are the same words, by symmetry.)
+    if (wide == tall) {
+        for (size_t j = 0; j < rowPlaces.size(); j++)
+            rowPlaces[j] |= colPlaces[j];
+        mRowTrie = mColTrie = newTrie(wordTries[wide], mRowWords, rowPlaces, mNumRowWords);
+        mNumColWords = mNumRowWords;
+    } else {
+        mRowTrie = newTrie(wordTries[wide], mRowWords, rowPlaces, mNumRowWords);
+        mColTrie = newTrie(wordTries[tall], mColWords, colPlaces, mNumColWords);
+    }
+    mRowNodes = mRowTrie->mTotalNodes;
+    mTries[wide] = mRowTrie;
+    mTries[tall] = mColTrie;
+    mSeconds = (double)(clock() - clockBeg) / CLOCKS_PER_SEC;
+}
+
+template <typename MapT>
+WordRectPruner<MapT>::~WordRectPruner()
+{
+    if (mColTrie != mRowTrie)
+        delete mColTrie;
+    delete mRowTrie;
+}
+
+template <typename MapT>
+void WordRectPruner<MapT>::handOffTo(WordRectFinder<MapT> *pWRF)
+{
+    pWRF->adoptTries(mRowTrie, mColTrie);
+    mRowTrie = mColTrie = NULL;
+}
+
+/** All the words of a fixed-length trie, in order, following the links from each word to the next stem. */
+template <typename MapT>
+void WordRectPruner<MapT>::listWords(const WordTrie<MapT, RectNode> *trie, std::vector<const char *>& words)
+{
+    for (const RectNode *node = trie->getFirstWordNode(); node != NULL; ) {
+        words.push_back(node->getStem());
+        const RectNode *nextStem = node->getNextStemNode();
+        node = nextStem != NULL ? nextStem->getFirstWordNode() : NULL;
+    }
+}
+
+/**
+* letters[(place*length + pos)*sNumChars + letter] is set if some word still allowed
+* in that place (row or column) has that letter at that position.
+*/
+template <typename MapT>
+void WordRectPruner<MapT>::findLetters(const std::vector<const char *>& words, const std::vector<uint64>& places
+    , int length, int numPlaces, std::vector<bool>& letters)
+{
+    letters.assign(numPlaces * length * sNumChars, false);
+    for (size_t j = 0; j < words.size(); j++) {
+        const uchr *word = (const uchr *)words[j];
+        for (int place = 0; place < numPlaces; place++) {
+            if (places[j] & (1ULL << place)) {
+                for (int pos = 0; pos < length; pos++)
+                    letters[(place * length + pos) * sNumChars + word[pos]] = true;
+            }
+        }
+    }
+}
+
+/**
+* Disallow each word in each place where one of its letters cannot go in its cell, which
+* for the letter at pos in place is cells[place*placeStride + pos*posStride + letter].
+* Returns the number of places taken away.
+*/
+template <typename MapT>
+uint WordRectPruner<MapT>::prunePlaces(const std::vector<const char *>& words, std::vector<uint64>& places
+    , int length, int numPlaces, const std::vector<bool>& cells, int placeStride, int posStride)
+{
+    uint changed = 0;
+    for (size_t j = 0; j < words.size(); j++) {
+        const uchr *word = (const uchr *)words[j];
+        for (int place = 0; place < numPlaces; place++) {
+            if (places[j] & (1ULL << place)) {
+                int pos = 0;
+                while (pos < length && cells[place * placeStride + pos * posStride + word[pos]])
+                    pos++;
+                if (pos < length) {
+                    places[j] &= ~(1ULL << place);
+                    changed++;
+                }
+            }
+        }
+    }
+    return changed;
+}
+
+/** New trie of the words that have any place left, inserted in order, sharing the words of the base trie. */
+template <typename MapT>
+WordTrie<MapT, RectNode> * WordRectPruner<MapT>::newTrie(const WordTrie<MapT, RectNode> *base
+    , const std::vector<const char *>& words, const std::vector<uint64>& places, uint& numWords)
+{
+    WordTrie<MapT, RectNode> *trie = new WordTrie<MapT, RectNode>(base->charMap(), base->getWordLength(), false);
+    RectNode *prevNode = NULL;
+    numWords = 0;
+    for (size_t j = 0; j < words.size(); j++) {
+        if (places[j] != 0) {
+            prevNode = trie->insertWord(words[j], prevNode);
+            numWords++;
+        }
+    }
+    return trie;
+}
@@ -0,0 +1,75 @@
+// WordRectPruner.hpp : shape-specific tries of only the words that can fit a word rect's rows or columns
+
+#ifndef WordRectPruner_hpp
+#define WordRectPruner_hpp
+
+#include <vector>
+
+#include "WordRectFinder.hpp"
+
+/**
+*   Dictionary reduction for one shape, wide x tall, before searching it.
+*   Each cell (r, i) of the rect can hold only letters that both some row word allowed in
+*   row r has at position i and some column word allowed in column i has at position r.
+*   A row word is allowed in row r only while each of its letters can go in its cell in
+*   that row, and likewise for column words and columns.  Taking a word out of a row or
+*   column may take letters out of cells, which may take more words out, so the pruner
+*   repeats until nothing changes (arc consistency, with the cells' letters as domains).
+*   A word allowed nowhere can never be part of a rect of this shape.
+*   The surviving words go into new tries, which point to the base tries' words instead
+*   of copying them.  Smaller tries mean fewer branches to try at every node of the search,
+*   and less memory to walk.  The finders use one trie for all the rows, so a word stays
+*   if it fits in any row: the first and last rows and columns, whose letters must start
+*   or end words, do most of the pruning.  For squares, rows and columns come from the
+*   same trie, so there is only one new trie.
+*/
+template <typename MapT>
+class WordRectPruner
+{
+public:
+    WordRectPruner(WordTrie<MapT, RectNode> *wordTries[], uint maxWordLength, int wide, int tall);
+    WordRectPruner(const WordRectPruner&);              // Prevent pass-by-value by not defining this copy constructor.
+    WordRectPruner& operator=(const WordRectPruner&);   // Prevent assignment by not defining this operator.
+    ~WordRectPruner();                                  // Deletes the shape's tries, unless a finder has adopted them.
+
+    /** Same as the array of all the tries, indexed by word length, but with this shape's tries at wide and tall. */
+    inline WordTrie<MapT, RectNode> ** getTries()           { return &mTries[0]; }
+
+    /** Give the shape's tries to the finder made from getTries(), so they last as long as it does. */
+    void                handOffTo(WordRectFinder<MapT> *pWRF);
+
+    inline uint         getNumRowWords()        const   { return mNumRowWords; }
+    inline uint         getNumColWords()        const   { return mNumColWords; }
+    inline uint         getNumBaseRowWords()    const   { return (uint)mRowWords.size(); }
+    inline uint         getNumBaseColWords()    const   { return (uint)mColWords.size(); }
+    inline uint         getNumRowNodes()        const   { return mRowNodes; }
+    inline uint         getNumBaseRowNodes()    const   { return mBaseRowNodes; }
+    inline int          getNumPasses()          const   { return mNumPasses; }
+    inline double       getSeconds()            const   { return mSeconds; }
+
+private:
+    static const uint   sNumChars = 256;    // letters are indexed by their unsigned char values
+    static const int    sMaxPlaces = 64;    // the rows or columns a word may go in are bits of a uint64
+
+    static void         listWords(const WordTrie<MapT, RectNode> *trie, std::vector<const char *>& words);
+    static void         findLetters(const std::vector<const char *>& words, const std::vector<uint64>& places
+                            , int length, int numPlaces, std::vector<bool>& letters);
+    static uint         prunePlaces(const std::vector<const char *>& words, std::vector<uint64>& places
+                            , int length, int numPlaces, const std::vector<bool>& cells, int placeStride, int posStride);
+    static WordTrie<MapT, RectNode> * newTrie(const WordTrie<MapT, RectNode> *base
+                            , const std::vector<const char *>& words, const std::vector<uint64>& places, uint& numWords);
+
+    std::vector<WordTrie<MapT, RectNode> *> mTries;
+    WordTrie<MapT, RectNode> *mRowTrie;     // NULL once handed off
+    WordTrie<MapT, RectNode> *mColTrie;     // == mRowTrie for squares
+    std::vector<const char *> mRowWords;    // all the words of the base tries, in order
+    std::vector<const char *> mColWords;
+    uint                mNumRowWords;       // words left
+    uint                mNumColWords;
+    uint                mRowNodes;
+    uint                mBaseRowNodes;
+    int                 mNumPasses;
+    double              mSeconds;
+};
+
+#endif // WordRectPruner_hpp
@@ -0,0 +1,97 @@
+// WordRectResults.cpp : on-disk store of what earlier runs learned about each word rect shape
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "WordRectResults.hpp"
+
+const char * const WordRectResults::sStatusNames[] = { "unknown", "some", "none", "all" };
+
+int WordRectResults::load()
+{
+    FILE *fp = fopen(mFileName.c_str(), "r");
+    if (fp == NULL)
+        return 0;                               // no file yet, so nothing is known
+    char line[4096];
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        if (line[0] == '#')
+            continue;
+        unsigned long long fingerprint = 0;
+        char kind[32], status[32];
+        int wide = 0, tall = 0, numRead = 0;
+        Result result;
+        result.mNumFound = 0;
+        result.mSeconds  = 0.0;
+        if (sscanf(line, "%llx %31s %d %d %31s %d %lf%n", &fingerprint, kind, &wide, &tall
+            , status, &result.mNumFound, &result.mSeconds, &numRead) < 7) {
+            continue;                           // not a result line
+        }
+        if (fingerprint != mFingerprint)
+            continue;                           // some other dictionary
+        result.mStatus = eUnknown;
+        for (int j = eSome; j <= eAll; j++) {
+            if (strcmp(status, sStatusNames[j]) == 0)
+                result.mStatus = (Status)j;
+        }
+        if (result.mStatus == eUnknown)
+            continue;
+        for (char *word = strtok(line + numRead, " \t\r\n"); word != NULL; word = strtok(NULL, " \t\r\n"))
+            result.mRows.push_back(word);
+        if (result.mRows.size() != 0 && (int)result.mRows.size() != tall)
+            continue;                           // truncated line
+        keep(makeKey(kind, wide, tall), result);
+    }
+    bool failed = ferror(fp) != 0;
+    fclose(fp);
+    return failed ? -1 : (int)mResults.size();
+}
+
+const WordRectResults::Result * WordRectResults::find(const char *kind, int wide, int tall) const
+{
+    std::map<std::string, Result>::const_iterator it = mResults.find(makeKey(kind, wide, tall));
+    return it != mResults.end() ? &it->second : NULL;
+}
+
+bool WordRectResults::record(const char *kind, int wide, int tall, const Result& result)
+{
+    if ( ! keep(makeKey(kind, wide, tall), result))
+        return true;                            // already knew as much
+    FILE *fp = fopen(mFileName.c_str(), "a");
+    if (fp == NULL)
+        return false;
+    fprintf(fp, "%016llx %s %d %d %s %d %.3f", mFingerprint, kind, wide, tall
+        , sStatusNames[result.mStatus], result.mNumFound, result.mSeconds);
+    for (size_t j = 0; j < result.mRows.size(); j++)
+        fprintf(fp, " %s", result.mRows[j].c_str());
+    fprintf(fp, "\n");
+    bool failed = ferror(fp) != 0;
+    return (fclose(fp) == 0) && !failed;
+}
+
+std::string WordRectResults::makeKey(const char *kind, int wide, int tall)
+{
+    char key[64];
+    sprintf(key, "%.31s %d %d", kind, wide, tall);
+    return key;
+}
+
+/** Exhaustive results beat partial ones, and then more rects beat fewer. */
+bool WordRectResults::isBetter(const Result& newer, const Result& older)
+{
+    bool newerIsAll = newer.mStatus != eSome;
+    bool olderIsAll = older.mStatus != eSome;
+    if (newerIsAll != olderIsAll)
+        return newerIsAll;
+    return newer.mNumFound > older.mNumFound;
+}
+
+/** Keep result under key unless one at least as good is already known.  Returns true if kept. */
+bool WordRectResults::keep(const std::string& key, const Result& result)
+{
+    std::map<std::string, Result>::iterator it = mResults.find(key);
+    if (it != mResults.end() && ! isBetter(result, it->second))
+        return false;
+    mResults[key] = result;
+    return true;
+}
@@ -0,0 +1,86 @@
+// WordRectResults.hpp : on-disk store of what earlier runs learned about each word rect shape
+
+#ifndef WordRectResults_hpp
+#define WordRectResults_hpp
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "wordTypes.h"
+
+/**
+*   Results of earlier searches, kept in a text file so that a later run on the same
+*   dictionary can skip the shapes they already decided.  Each line is one result:
+*
+*       fingerprint kind wide tall status numFound seconds [row words...]
+*
+*   The fingerprint is a hash of the dictionary's words as loaded (see fnv1a), so
+*   results for different word lists or length limits can share a file without mixing.
+*   The kind is the sort of finder (rect, lattice, or waffle, or grid- and the grid pattern's
+*   name or mask's hash), the status one of:
+*       none    the search was exhaustive and found nothing: a proof that there is no rect
+*       all     the search was exhaustive and found numFound rects
+*       some    the search stopped after numFound rects, wanting no more
+*   and seconds is how long the search took.  The rows are the last rect found, if any.
+*   Lines are only ever appended; when one shape has several, the most decisive
+*   (none or all before some, then the most rects) wins.
+*/
+class WordRectResults
+{
+public:
+    typedef enum {
+        eUnknown    = 0,
+        eSome       = 1,
+        eNone       = 2,
+        eAll        = 3,
+    } Status;
+
+    struct Result
+    {
+        Status                   mStatus;
+        int                      mNumFound;
+        double                   mSeconds;
+        std::vector<std::string> mRows;
+    };
+
+    static const uint64 sFnvOffset = 14695981039346656037ULL;
+    static const uint64 sFnvPrime  = 1099511628211ULL;
+
+    /** Hash the bytes of str into hash (64-bit FNV-1a), so words can be hashed one after another. */
+    static uint64 fnv1a(const char *str, uint64 hash = sFnvOffset)
+    {
+        for (const unsigned char *pc = (const unsigned char *)str; *pc != '\0'; pc++) {
+            hash ^= *pc;
+            hash *= sFnvPrime;
+        }
+        return hash;
+    }
+
+    WordRectResults(const char *fileName, uint64 fingerprint) : mFileName(fileName), mFingerprint(fingerprint) { }
+
+    /** Read the results for this fingerprint.  Returns how many shapes are known, or -1 on a read error. */
+    int                 load();
+
+    /** The best known result for this kind and shape, or NULL. */
+    const Result      * find(const char *kind, int wide, int tall) const;
+
+    /** Keep a new result, and append it to the file.  Returns false if the file could not be written. */
+    bool                record(const char *kind, int wide, int tall, const Result& result);
+
+    inline uint64       getFingerprint()    const   { return mFingerprint; }
+    inline const char * getFileName()       const   { return mFileName.c_str(); }
+    inline const char * getStatusName(Status status) const { return sStatusNames[status]; }
+
+private:
+    static const char * const sStatusNames[];
+    static std::string  makeKey(const char *kind, int wide, int tall);
+    static bool         isBetter(const Result& newer, const Result& older);
+    bool                keep(const std::string& key, const Result& result);
+
+    std::string         mFileName;
+    uint64              mFingerprint;
+    std::map<std::string, Result> mResults;     // by kind and shape
+};
+
+#endif // WordRectResults_hpp
@@ -19,6 +19,9 @@
 // project headers, including template class & method declarations:
 #include "WordRectSearchExec.hpp"
 #include "TrixNode.hpp"
+#include "AutoCompleter.hpp"
+#include "WordFuzzyMatcher.hpp"
+#include "WordPatternMatcher.hpp"
 
 // project template class & template method definitions:
 #include "TracNode.cpp"
@@ -41,7 +44,7 @@ void WordRectSearchExec::setOptions(uint managerFlags, uint minCharCount, uint m
     mManagerFlags   = managerFlags;
     mSingleThreaded = (managerFlags & eSingleThreaded)	 > 0 ? true : false;
     mUseTracNodes   = (managerFlags & eTransformIndexes) > 0 ? true : false;
-    mUseMaps        = (managerFlags & WordRectSearchExec::eUseMaps) > 0 ? true : false;
+    mUseArrays      = (managerFlags & WordRectSearchExec::eUseArrays) > 0 ? true : false;
     mMinWordLength  = minWordLength;
     mMinCharCount   = minCharCount;
     mMaxWordLength  = maxWordLength;
@@ -81,8 +84,16 @@ static void test_freqMap(const CharFreqMap& charFreqMap)
 int WordRectSearchExec::startupSearchManager(const char *dictFile
     , uint minArea, uint minTall, uint maxTall, uint maxArea, uint numEach, uint numTot)
 {   
+    // Read the dictionary just once: the char counts come from the same pass that finds the words,
+    // and the tries copy the words from the file's text into one pool per word length, after
+    // which the text is freed.
+    if (mMaxWordLength >= sMaxWordLength)
+        mMaxWordLength = sMaxWordLength - 1;    // no longer limited by a line buffer, but by the tries' arrays
+    WordListFile wordList;
+    if (wordList.load(dictFile, mMinWordLength, mMaxWordLength) < 0)
+        return -1;
     CharFreqMap charFreqMap(dictFile, mMinWordLength, mMaxWordLength, mMinCharCount); 
-    int err = charFreqMap.initFromFile(mMinCharCount, mMinWordLength, mMaxWordLength, mVerbosity);
+    int err = charFreqMap.initFromWordList(wordList, mMinCharCount, mVerbosity);
     if (err < 0)
         return err;
     const CharMap::SubType defaultType = charFreqMap.getDefaultCharMapSubType(); 
@@ -97,11 +108,11 @@ int WordRectSearchExec::startupSearchManager(const char *dictFile
     if (mMaxWordLength > maxFoundWordLength)
         mMaxWordLength = maxFoundWordLength;
 
-    if (mUseMaps) {
+    if (mUseArrays) {
 #ifdef _MBCS
-        mWordMaps = mWordMapsMem;   // TODO: why not new?
+        mWordArrays = mWordArraysMem;   // TODO: why not new?
 #else
-        mWordMaps = new WordMap[mMaxWordLength+1];  // index wordMaps by word length (not length-1)
+        mWordArrays = new WordArray[mMaxWordLength+1];  // index word arrays by word length (not length-1)
 #endif
     }
 
@@ -117,19 +128,64 @@ int WordRectSearchExec::startupSearchManager(const char *dictFile
 
     // index array of tries by word length (not by strlen(word) - 1); mTries[0] remains NULL. 
     //mBaseTries = (WordTrie<CharMap> **)calloc(maxLineLength+1, sizeof(WordTrie<CharMap> *));
-    mBaseTries = new WordTrie<CharMap, TrixNode>*[mMaxWordLength+1]; // index wordMaps by word length
+    mBaseTries = new WordTrie<CharMap, RectNode>*[mMaxWordLength+1]; // index wordMaps by word length
+    const bool reversed = (mManagerFlags & eOrientShapes) != 0;
+    if (reversed)
+        mRevTries = new WordTrie<CharMap, RectNode>*[mMaxWordLength+1];
 
 #if USE_VIRT_CHAR_IDX
     // create (and later delete) the tries in a loop; we don't want a default constructor
-    for (uint wordLen = 1; wordLen <= mMaxWordLength; wordLen++)
-        mBaseTries[wordLen] = new WordTrie<CharMap, TrixNode>(charMap, wordLen);
-    mNumWords += initFromSortedDictionaryFile(dictFile, charMap, mBaseTries, mWordMaps, mMinWordLength, mMaxWordLength);
+#if USE_TRY_NODES
+    // TryNodes get their branch slots from the per-position char counts of their trie's words.
+    // The reversed tries have their own, since their words' first chars are the others' last.
+    mPosMaps.assign(mMaxWordLength+1, NULL);
+    mRevPosMaps.assign(reversed ? mMaxWordLength+1 : 0, NULL);
+    for (uint wordLen = 1; wordLen <= mMaxWordLength; wordLen++) {
+        mPosMaps[wordLen] = new CharPosMap(charMap, wordLen);
+        if (reversed)
+            mRevPosMaps[wordLen] = new CharPosMap(charMap, wordLen);
+    }
+    char backwards[sMaxWordLength];
+    for (uint j = 0; j < wordList.getNumWords(); j++) {
+        uint length = wordList.getLength(j);
+        if (mMinWordLength <= length && length <= mMaxWordLength) {
+            const char *word = wordList.getWord(j);
+            mPosMaps[length]->addWord(word);
+            if (reversed) {
+                std::reverse_copy(word, word + length, backwards);
+                backwards[length] = '\0';
+                mRevPosMaps[length]->addWord(backwards);
+            }
+        }
+    }
+    for (uint wordLen = 1; wordLen <= mMaxWordLength; wordLen++) {
+        mPosMaps[wordLen]->initSlots();
+        if (mVerbosity > 2 && wordLen >= mMinWordLength)
+            mPosMaps[wordLen]->printSlots();
+        mBaseTries[wordLen] = new WordTrie<CharMap, RectNode>(*mPosMaps[wordLen], wordLen, true);
+        if (reversed) {
+            mRevPosMaps[wordLen]->initSlots();
+            mRevTries[wordLen] = new WordTrie<CharMap, RectNode>(*mRevPosMaps[wordLen], wordLen, true);
+        }
+    }
+#else
+    for (uint wordLen = 1; wordLen <= mMaxWordLength; wordLen++) {
+        mBaseTries[wordLen] = new WordTrie<CharMap, RectNode>(charMap, wordLen, true);
+        if (reversed)
+            mRevTries[wordLen] = new WordTrie<CharMap, RectNode>(charMap, wordLen, true);
+    }
+#endif
+    mNumWords += initFromWordList(wordList, charMap, mBaseTries, mWordArrays, mMinWordLength, mMaxWordLength, numLoadThreads(), mRevTries);
     if (mNumWords == 0) {
         printf("SearchExec Found no words in dictionary %s.  Aborting.)\n", dictFile);
         return -2;
     }
+    if (mPatterns != NULL)
+        return matchPatterns(mPatterns, wordList.getCodePointMap());
+    if (mNearWords != NULL)
+        return matchNearWords(mNearWords, wordList.getCodePointMap());
 
-    WordRectSearchMgr<CharMap> *searchMgr = new WordRectSearchMgr<CharMap>(mBaseTries, mWordMaps
+    WordRectSearchMgr<CharMap> *searchMgr = new WordRectSearchMgr<CharMap>(mBaseTries, mWordArrays
         , mManagerFlags, mVerbosity);
 #else
     FreqFirstCharMap *pFFCM = (FreqFirstCharMap *) &charMap;
@@ -140,13 +196,13 @@ int WordRectSearchExec::startupSearchManager(const char *dictFile
         return -1;
     }
     for (uint wordLen = 1; wordLen <= maxLineLength; wordLen++)
-        mBaseTries[wordLen] =  (WordTrie<CharMap> *) new WordTrie<FreqFirstCharMap>(*pFFCM, wordLen);
-    mNumWords += initFromSortedDictionaryFile(dictFile, *pFFCM, (WordTrie<FreqFirstCharMap>**)mBaseTries, mWordMaps, mMaxWordLength);
+        mBaseTries[wordLen] =  (WordTrie<CharMap> *) new WordTrie<FreqFirstCharMap>(*pFFCM, wordLen, true);
+    mNumWords += initFromWordList(wordList, *pFFCM, (WordTrie<FreqFirstCharMap>**)mBaseTries, mWordArrays, mMaxWordLength);
     if (mNumWords == 0) {
         printf("SearchExec Found no words in dictionary %s.  Aborting.)\n", dictFile);
         return -2;
     }
-    WordRectSearchMgr<FreqFirstCharMap> *searchMgr = new WordRectSearchMgr<FreqFirstCharMap>((WordTrie<FreqFirstCharMap>**)mBaseTries, mWordMaps
+    WordRectSearchMgr<FreqFirstCharMap> *searchMgr = new WordRectSearchMgr<FreqFirstCharMap>((WordTrie<FreqFirstCharMap>**)mBaseTries, mWordArrays
         , mManagerFlags, mFinderOptions, mVerbosity);
 #endif
 
@@ -158,8 +214,11 @@ int WordRectSearchExec::startupSearchManager(const char *dictFile
     FreqFirstWildCharMap *pFFWCM = new FreqFirstWildCharMap(charFreqMap, 1000); 
     WordTrie<FreqFirstWildCharMap, TracNode> wtf(*pFFWCM, 0);
     int numAdded = 0;
-    numAdded = WordTrie<FreqFirstWildCharMap, TracNode>::addAllWordsInTextFile(dictFile, &wtf, mMinWordLength, mMaxWordLength, mVerbosity);
+    numAdded = WordTrie<FreqFirstWildCharMap, TracNode>::addAllWordsInTextFile(dictFile, &wtf, mMinWordLength, mMaxWordLength, mVerbosity
+        , numLoadThreads());
     assert(numAdded > 0);
+    if (mManagerFlags & eTryTracNodes)
+        AutoCompleter::test_AutoCompleter(wtf.getRoot(), mVerbosity);
 ////numAdded = WordTrie<FreqFirstWildCharMap, TracNode>::addAllWordsInTextFile(dictFile, &wtf, mMinWordLength, mMaxWordLength, mVerbosity);
 ////assert(numAdded == 0);
 
@@ -173,13 +232,26 @@ int WordRectSearchExec::startupSearchManager(const char *dictFile
     }
 
 #ifndef __APPLE__
-    numAdded = WordTrie<FreqFirstWildCharMap, TracNode>::addAllWordsInTextFile("../MarkTwain/TomSawyer_En.txt", &wtf, mMinWordLength, mMaxWordLength, mVerbosity);
+    numAdded = WordTrie<FreqFirstWildCharMap, TracNode>::addAllWordsInTextFile("../MarkTwain/TomSawyer_En.txt", &wtf, mMinWordLength, mMaxWordLength, mVerbosity
+        , numLoadThreads());
     assert(numAdded > 0);
 #endif
 
 #endif
 
-    searchMgr->manageSearch(minArea, minTall, maxTall, maxArea, mMaxWordLength, numEach, numTot);
+    searchMgr->setTimeBudget(mTimeBudget);
+    searchMgr->setNumShuffleFinders(mNumShufflers);
+    searchMgr->setFrontierDepth(mFrontierDepth);
+    searchMgr->setResultsFile(mResultsFile);
+    searchMgr->setReverseTries(mRevTries, mOrientation);
+    if (mGridMask != NULL && searchMgr->setGridMask(mGridMask, mMaxWordLength) < 0)
+        return -3;
+    if (mNumProbes > 0)
+        searchMgr->estimateSearch(minArea, minTall, maxTall, maxArea, mMaxWordLength, mNumProbes);
+    else if (mManagerFlags & eCountByStates)
+        searchMgr->countSearch(minArea, minTall, maxTall, maxArea, mMaxWordLength, mNumSamples);
+    else
+        searchMgr->manageSearch(minArea, minTall, maxTall, maxArea, mMaxWordLength, numEach, numTot);
 
 #else
 
@@ -195,9 +267,9 @@ int WordRectSearchExec::startupSearchManager(const char *dictFile
 
             mIdentTries = new WordTrie<IdentCharMap>*[maxLineLength+1];
             for (int wordLen = 1; wordLen <= maxLineLength; wordLen++)
-                mIdentTries[wordLen] = new WordTrie<IdentCharMap>(identCharMap, wordLen);
-            mNumWords += initFromSortedDictionaryFile(dictFile, identCharMap, mIdentTries, mWordMaps, mMaxWordLength);
-            WordRectSearchMgr<IdentCharMap> *searchMgr = new WordRectSearchMgr<IdentCharMap>(mIdentTries, mWordMaps
+                mIdentTries[wordLen] = new WordTrie<IdentCharMap>(identCharMap, wordLen, true);
+            mNumWords += initFromWordList(wordList, identCharMap, mIdentTries, mWordArrays, mMaxWordLength);
+            WordRectSearchMgr<IdentCharMap> *searchMgr = new WordRectSearchMgr<IdentCharMap>(mIdentTries, mWordArrays
                 , mManagerFlags, mFinderOptions, mVerbosity);
             searchMgr->manageSearch(minArea, minTall, maxTall, maxArea, mMaxWordLength);
         }
@@ -208,9 +280,9 @@ int WordRectSearchExec::startupSearchManager(const char *dictFile
             assert(&defaultCharMap == &compactCharMap);
             mCompactTries = new WordTrie<CompactCharMap>*[maxLineLength+1];
             for (int wordLen = 1; wordLen <= maxLineLength; wordLen++)
-                mCompactTries[wordLen] = new WordTrie<CompactCharMap>(compactCharMap, wordLen);
-            mNumWords += initFromSortedDictionaryFile(dictFile, compactCharMap, mCompactTries, mWordMaps, mMaxWordLength);
-            WordRectSearchMgr<CompactCharMap> *searchMgr = new WordRectSearchMgr<CompactCharMap>(mCompactTries, mWordMaps
+                mCompactTries[wordLen] = new WordTrie<CompactCharMap>(compactCharMap, wordLen, true);
+            mNumWords += initFromWordList(wordList, compactCharMap, mCompactTries, mWordArrays, mMaxWordLength);
+            WordRectSearchMgr<CompactCharMap> *searchMgr = new WordRectSearchMgr<CompactCharMap>(mCompactTries, mWordArrays
                 , mManagerFlags, mFinderOptions, mVerbosity);
             searchMgr->manageSearch(minArea, minTall, maxTall, maxArea, mMaxWordLength);
         }
@@ -222,9 +294,9 @@ int WordRectSearchExec::startupSearchManager(const char *dictFile
 
             mFreqTries = new WordTrie<FreqFirstCharMap>*[maxLineLength+1];
             for (int wordLen = 1; wordLen <= maxLineLength; wordLen++)
-                mFreqTries[wordLen] = new WordTrie<FreqFirstCharMap>(freqFirstCharMap, wordLen);
-            mNumWords += initFromSortedDictionaryFile(dictFile, freqFirstCharMap, mFreqTries, mWordMaps, mMaxWordLength);
-            WordRectSearchMgr<FreqFirstCharMap> *searchMgr = new WordRectSearchMgr<FreqFirstCharMap>(mFreqTries, mWordMaps
+                mFreqTries[wordLen] = new WordTrie<FreqFirstCharMap>(freqFirstCharMap, wordLen, true);
+            mNumWords += initFromWordList(wordList, freqFirstCharMap, mFreqTries, mWordArrays, mMaxWordLength);
+            WordRectSearchMgr<FreqFirstCharMap> *searchMgr = new WordRectSearchMgr<FreqFirstCharMap>(mFreqTries, mWordArrays
                 , mManagerFlags, mFinderOptions, mVerbosity);
             searchMgr->manageSearch(minArea, minTall, maxTall, maxArea, mMaxWordLength);
         }
@@ -242,82 +314,245 @@ int WordRectSearchExec::destroySearchManager()
     return 0; 
 }
 
+#if USE_BASE_CHAR_MAP
+static bool collectPatternMatch(uint patternIdx, const char *word, void *context)
+{
+    std::vector< std::vector<const char *> > *matches = (std::vector< std::vector<const char *> > *)context;
+    (*matches)[patternIdx].push_back(word);
+    return true;
+}
+
+int WordRectSearchExec::matchPatterns(const char *patternList, const CodePointMap& codePoints) const
+{
+    // Parse the patterns (in the dictionary's codes), and group them by length, since each length has its own trie.
+    std::vector<WordPattern> patterns;
+    std::vector<std::string> texts;
+    for (const char *pc = patternList; *pc != '\0'; ) {
+        const char *end = strchr(pc, ',');
+        if (end == NULL)
+            end = pc + strlen(pc);
+        std::string text(pc, end - pc);
+        pc = *end == ',' ? end + 1 : end;
+        if (text.empty())
+            continue;
+        texts.push_back(text);
+        text.resize(codePoints.encode(&text[0], (uint)text.size(), true));
+        patterns.push_back(WordPattern());
+        if ( ! patterns.back().parse(text.c_str())) {
+            printf("Bad word pattern: %s  (unclosed [ or empty set)\n", texts.back().c_str());
+            return -3;
+        }
+    }
+    std::vector< std::vector<WordPattern> > patternsOfLength(mMaxWordLength + 1);
+    std::vector< std::vector<uint> > indicesOfLength(mMaxWordLength + 1);
+    for (uint j = 0; j < patterns.size(); j++) {
+        uint length = patterns[j].getLength();
+        if (mMinWordLength <= length && length <= mMaxWordLength) {
+            patternsOfLength[length].push_back(patterns[j]);
+            indicesOfLength[length].push_back(j);
+        }
+    }
+
+    std::vector< std::vector<const char *> > matches(patterns.size()), lengthMatches;
+    for (uint length = mMinWordLength; length <= mMaxWordLength; length++) {
+        uint numPatterns = (uint)patternsOfLength[length].size();
+        if (numPatterns == 0)
+            continue;
+        lengthMatches.assign(numPatterns, std::vector<const char *>());
+        WordPatternMatcher<CharMap, RectNode> matcher(*mBaseTries[length]);
+        matcher.matchAll(&patternsOfLength[length][0], numPatterns, collectPatternMatch, &lengthMatches);
+        for (uint j = 0; j < numPatterns; j++)
+            matches[indicesOfLength[length][j]].swap(lengthMatches[j]);
+    }
 
-// Loads from the file only once; no re-loading after init.  Modifies rMaxWordLength.
+    uint total = 0;
+    char word[CodePointMap::sMaxTextLen * sMaxWordLength];
+    for (uint j = 0; j < patterns.size(); j++) {
+        printf("%s: %d\n", texts[j].c_str(), (int)matches[j].size());
+        if (mVerbosity > 1) {
+            for (uint k = 0; k < matches[j].size(); k++)
+                printf("    %s\n", CodePointMap::decode(matches[j][k], word, sizeof(word)));
+        }
+        total += (uint)matches[j].size();
+    }
+    if (mVerbosity > 0)
+        printf("Matched %d words to %d patterns.\n", total, (int)patterns.size());
+    return 0;
+}
+
+int WordRectSearchExec::matchNearWords(const char *wordList, const CodePointMap& codePoints) const
+{
+    typedef WordFuzzyMatcher<CharMap, RectNode> Matcher;
+    Matcher matcher(mBaseTries, mMinWordLength, mMaxWordLength);
+    Matcher::Match nearest[Matcher::sDefaultK];
+    char text[CodePointMap::sMaxTextLen * sMaxWordLength];
+    uint numWords = 0;
+    clock_t clockBeg = clock();
+    for (const char *pc = wordList; *pc != '\0'; ) {
+        const char *end = strchr(pc, ',');
+        if (end == NULL)
+            end = pc + strlen(pc);
+        std::string word(pc, end - pc);
+        pc = *end == ',' ? end + 1 : end;
+        if (word.empty())
+            continue;
+        printf("%s:", word.c_str());
+        word.resize(codePoints.encode(&word[0], (uint)word.size(), true));
+        uint numNearest = matcher.findNearest(word.c_str(), Matcher::sDefaultMaxDist, Matcher::sDefaultK, nearest);
+        for (uint j = 0; j < numNearest; j++)
+            printf("  %s %d", CodePointMap::decode(nearest[j].mWord, text, sizeof(text)), nearest[j].mDistance);
+        printf("\n");
+        ++numWords;
+    }
+    double seconds = (double)(clock() - clockBeg) / CLOCKS_PER_SEC;
+    if (mVerbosity > 0)
+        printf("Found the words within distance %d of %d words in %.4f seconds.\n", Matcher::sDefaultMaxDist, numWords, seconds);
+    return 0;
+}
+#endif
+
+
+// Loads the words only once; no re-loading after init.
 template <typename MapT>
-uint WordRectSearchExec::initFromSortedDictionaryFile(const char *fileSpec, const MapT &charMap
-    , WordTrie<MapT, TrixNode> *wordTries[], WordMap *wordMaps, uint minWordLength, uint maxWordLength)
+uint WordRectSearchExec::initFromWordList(const WordListFile& wordList, const MapT &charMap
+    , WordTrie<MapT, RectNode> *wordTries[], WordArray *wordArrays, uint minWordLength, uint maxWordLength, uint numThreads
+    , WordTrie<MapT, RectNode> *revTries[])
 {   
-    // This method allocates memory for holding all the words, and that memory is retained 
-    // until the process terminates.  So it should succeed only once.
+    // Loading twice would put each word in its trie twice.  So it should succeed only once.
     static bool alreadyLoaded = false;
     if (alreadyLoaded) {
         return 0;
     }
     alreadyLoaded = true;
 
-    FILE *fi;
-    if ( ! fopen_safe(&fi, fileSpec, "r") ) {
-        printf("%s opened by %s\n" , fileSpec, __FUNCTION__);
-    } else {
-        printf("Error opening dictionary file: %s\n", fileSpec);
-        return 0;
+    // The tries (and word arrays) of different lengths share nothing, so they can be built at the
+    // same time.  List each length's words, in order, and then give each thread some lengths,
+    // the longest lists first, each to the thread with the fewest words so far.
+    std::vector<uint> wordsOfLength[sMaxWordLength];
+    for (uint j = 0; j < wordList.getNumWords(); j++) {
+        uint length = wordList.getLength(j);
+        if (minWordLength <= length && length <= maxWordLength)
+            wordsOfLength[length].push_back(j);
     }
-
-    TrixNode *prevNode[sMaxWordLength] = { NULL, };
-    uint  length, numWords = 0;
-    uint  endMapIdx = charMap.targetEndIdx();
-    char  line[CharFreqMap::sBufSize];
-    while (fgets(line, CharFreqMap::sBufSize, fi))  {
-        // Got next NULL-terminated line from the dictionary text file.
-        // Extract the first word as the sequence of all the chars before
-        // the NULL or any other char <= sBegChar (default: the SPACE char).
-        // Thus the first whitespace or control-char, including LF (line feed,
-        // new line, \n), TAB, VT, FF, CR (carriage return), ESC, FS, and 
-        // of course Space, will end the word and be replaced with NULL
-        // if a copy of this string is to be saved as a word.
-        // If the raw string contains any other non-mapped character
-        // before the first word-terminator, it must be rejected, 
-        // since the wordTrie cannot store it.  If we do extract a word,
-        // we must also compute its length before saving it.
-
-        register char *ptrSigned = line;            // pointer to signed char
-        for ( ; ; ++ptrSigned) {
-            register uchr valUnsigned = *ptrSigned; // value as unsigned char
-            if (valUnsigned > CharFreqMap::sBegChar) {
-                // reject any string with unmapped char
-                uint idx = charMap.charToIndex(valUnsigned);
-                if (idx >= endMapIdx) {
-                    goto GET_NEXT_LINE;
-                }
-            } else {
-                // The string up to here is a valid word.  
-                // NULL-terminate it, then add it to the trie.
-                *ptrSigned = NULL;
-                break;
-            }
+    std::vector<uint> lengths;
+    for (uint length = minWordLength; length <= maxWordLength; length++) {
+        if ( ! wordsOfLength[length].empty())
+            lengths.push_back(length);
+    }
+    uint numLoaders = numThreads < lengths.size() ? numThreads : (uint)lengths.size();
+    if (numLoaders < 1)
+        numLoaders = 1;
+    std::vector< TrieLoader<MapT> > loaders(numLoaders);
+    for (uint k = 0; k < lengths.size(); k++) {
+        uint maxK = k;
+        for (uint m = k + 1; m < lengths.size(); m++) {
+            if (wordsOfLength[lengths[maxK]].size() < wordsOfLength[lengths[m]].size())
+                maxK = m;
+        }
+        std::swap(lengths[k], lengths[maxK]);
+        uint minLoader = 0;
+        for (uint t = 1; t < numLoaders; t++) {
+            if (loaders[minLoader].mNumToLoad > loaders[t].mNumToLoad)
+                minLoader = t;
         }
+        loaders[minLoader].mLengths.push_back(lengths[k]);
+        loaders[minLoader].mNumToLoad += (uint)wordsOfLength[lengths[k]].size();
+    }
 
-        // filter by word length
-        length = uint(ptrSigned - line);   // pointer arithmetic
-        if (length < minWordLength || maxWordLength < length)
-            continue;
+    std::vector<void *> loaderArgs(numLoaders);
+    for (uint t = 0; t < numLoaders; t++) {
+        loaders[t].mWordList      = &wordList;
+        loaders[t].mCharMap       = &charMap;
+        loaders[t].mWordTries     = wordTries;
+        loaders[t].mRevTries      = revTries;
+        loaders[t].mWordArrays    = wordArrays;
+        loaders[t].mWordsOfLength = wordsOfLength;
+        loaderArgs[t] = &loaders[t];
+    }
+    if (numLoaders > 1)
+        runWorkerThreads(loadTries<MapT>, &loaderArgs[0], (int)numLoaders);
+    else
+        loadTries<MapT>(loaderArgs[0]);
+
+    uint numWords = 0;
+    for (uint t = 0; t < numLoaders; t++)
+        numWords += loaders[t].mNumLoaded;
+    return numWords;
+}
 
-        numWords++;
-        prevNode[length] = wordTries[length]->insertWord(line, prevNode[length]);
-        if (wordMaps != NULL) {
-            assert(length > 0);
-            // Duplicate the input line up to the NULL.
-            // This allocates this word's memory for the life of the program, i.e.,
-            // it is free'd only on program exit, though some TrieNode could be
-            // construed as its unique owner, and everyone else only a borrower -- but, which TrieNode??
-            const char *saveWord = strdup_safe(line);		
-            wordMaps[length].insert(WordMap::value_type(saveWord, numWords));   // strictly increasing value preserves the order
+// Builds the tries (and word arrays, and reversed tries) of the lengths given to one TrieLoader.  Runs in a worker thread.
+template <typename MapT>
+void WordRectSearchExec::loadTries(void *pvLoader)
+{
+    TrieLoader<MapT> *loader = (TrieLoader<MapT> *)pvLoader;
+    const WordListFile& wordList = *loader->mWordList;
+    uint endMapIdx = loader->mCharMap->targetEndIdx();
+    for (uint k = 0; k < loader->mLengths.size(); k++) {
+        uint length = loader->mLengths[k];
+        const std::vector<uint>& wordIndices = loader->mWordsOfLength[length];
+        WordTrie<MapT, RectNode> *wordTrie = loader->mWordTries[length];
+
+        // The trie's links need its words in order, but the word list need not be sorted,
+        // or may be a merge of sorted lists; if so, sort this length's words here.
+        std::vector<const char *> words(wordIndices.size());
+        for (uint w = 0; w < wordIndices.size(); w++)
+            words[w] = wordList.getWord(wordIndices[w]);
+        wordTrie->sortWords(words);
+
+        // Size the trie's word pool to hold all its words, so that they end up back to back, in order.
+        wordTrie->reserveWords((uint)words.size());
+
+        std::vector<const char *> loaded;   // the words put in the trie, for the word array, if any
+        RectNode *prevNode = NULL;
+        for (uint w = 0; w < words.size(); w++) {
+            // The word list already NULL-terminated the first word of each line at its first
+            // whitespace or control-char (LF, TAB, CR, ... or Space).  Any other char that
+            // is not mapped means the word must be rejected, since the wordTrie cannot store it.
+            const char *word = words[w];
+            uint j = 0;
+            while (j < length && loader->mCharMap->charToIndex((uchr)word[j]) < endMapIdx)
+                j++;
+            if (j < length)
+                continue;           // reject any string with unmapped char
+
+            RectNode *newNode = wordTrie->insertWord(word, prevNode);
+            if (newNode == NULL)
+                continue;           // a repeat: the next word still follows the previous one
+            prevNode = newNode;
+            loader->mNumLoaded++;
+            if (loader->mWordArrays != NULL)
+                loaded.push_back(newNode->getStem());
+        }
+        if (loader->mWordArrays != NULL)
+            loader->mWordArrays[length].assign(loaded, length);
+
+        // The reversed trie gets the same words, spelled backwards and sorted again.  The forward
+        // trie's pool already has each word once, so reverse those into one buffer for the copy.
+        if (loader->mRevTries != NULL) {
+            WordTrie<MapT, RectNode> *revTrie = loader->mRevTries[length];
+            std::vector<char> backwards;
+            backwards.reserve(words.size() * (length + 1));
+            for (const RectNode *node = wordTrie->getFirstWordNode(); node != NULL; ) {
+                const char *word = node->getStem();
+                for (uint j = length; j-- > 0; )
+                    backwards.push_back(word[j]);
+                backwards.push_back('\0');
+                const RectNode *nextStem = node->getNextStemNode();
+                node = nextStem != NULL ? nextStem->getFirstWordNode() : NULL;
+            }
+            words.resize(backwards.size() / (length + 1));
+            for (uint w = 0; w < words.size(); w++)
+                words[w] = &backwards[w * (length + 1)];
+            revTrie->sortWords(words);
+            revTrie->reserveWords((uint)words.size());
+            prevNode = NULL;
+            for (uint w = 0; w < words.size(); w++) {
+                RectNode *newNode = revTrie->insertWord(words[w], prevNode);
+                if (newNode != NULL)
+                    prevNode = newNode;
+            }
         }
-GET_NEXT_LINE: continue;
     }
-    fclose(fi);
-    return numWords;
 }
 
 
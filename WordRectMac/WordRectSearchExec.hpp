@@ -5,6 +5,7 @@
 #define WordRectSearchExec_hpp
 
 #include "WordRectFinder.hpp"
+#include "WordListFile.hpp"
 
 #ifdef _MBCS	// Microsoft Compiler
 #define WIN32_LEAN_AND_MEAN	// Exclude bells and whistles from Windows headers (e.g. Media Center Extensions)
@@ -33,9 +34,13 @@ public:
         eSingleThreaded     =  16,
         eAbortIfTrumped     =  32,
         eTryTracNodes       =  64,
-        eUseMaps            = 128,
+        eUseArrays          = 128,    // Find rect rows in sorted arrays of words instead of tries (-m)
         eTransformIndexes   = 256,
         eUseAltAlg          = 512,
+        eCountOnly          = 1024,   // Count all rects of each size, without printing or stopping for them
+        eCountByStates      = 2048,   // Count short rects by dynamic programming over the columns' trie states
+        ePruneShapes        = 4096,   // Search each rect shape with tries of only the words that can fit it
+        eOrientShapes       = 8192,   // Load reversed tries too, and fill each rect shape from its best side
 
     } ManagerOptions;
 
@@ -55,6 +60,16 @@ public:
     }
 
     void setOptions(uint managerFlags, uint minCharCount, uint minWordLength, uint maxWordLength, int verbose);
+    void setTimeBudget(uint seconds) { mTimeBudget = seconds; }    // anytime mode, if > 0
+    void setNumShuffleFinders(uint num) { mNumShufflers = num; }   // randomized restarts, if > 0
+    void setNumProbes(uint num) { mNumProbes = num; }              // only estimate search sizes, if > 0
+    void setNumSamples(uint num) { mNumSamples = num; }            // random rects to show when counting by states
+    void setFrontierDepth(uint depth) { mFrontierDepth = depth; }  // share this many rows across heights, if > 0
+    void setResultsFile(const char *fileName) { mResultsFile = fileName; }  // results of earlier runs, if not NULL
+    void setPatterns(const char *patterns) { mPatterns = patterns; }       // only match these word patterns, if not NULL
+    void setNearWords(const char *words) { mNearWords = words; }           // only find the words nearest these, if not NULL
+    void setGridMask(const char *mask) { mGridMask = mask; }               // fill this grid mask or pattern instead of rects, if not NULL
+    void setOrientation(RectOrientation side) { mOrientation = side; }     // side to fill rects from, with eOrientShapes
 
     int  startupSearchManager(const char *dictFileSpec
         , uint minArea, uint minTall
@@ -70,27 +85,33 @@ public:
 private:
     WordRectSearchExec()        // private default constructor
 #if	USE_BASE_CHAR_MAP
-        : mBaseTries(NULL)
+        : mBaseTries(NULL), mRevTries(NULL)
 #else
         : mCompactTries(NULL), mIdentTries(NULL), mFreqTries(NULL)
 #endif
-        , mWordMaps(NULL), mNumWords(0), mMaxWordLength(0)
-        , mManagerFlags(0), mVerbosity(0)
-        , mSingleThreaded(false), mUseMaps(false)
+        , mWordArrays(NULL), mNumWords(0), mMaxWordLength(0)
+        , mManagerFlags(0), mVerbosity(0), mTimeBudget(0), mNumShufflers(0), mNumProbes(0), mNumSamples(0), mFrontierDepth(0), mResultsFile(NULL), mPatterns(NULL), mNearWords(NULL), mGridMask(NULL)
+        , mOrientation(eBestSideFirst)
+        , mSingleThreaded(false), mUseArrays(false)
     {}
     WordRectSearchExec(const WordRectSearchExec&);                // don't define
     WordRectSearchExec& operator=(const WordRectSearchExec&);     // don't define
     ~WordRectSearchExec() {
 #if	USE_BASE_CHAR_MAP
         deleteTries(mBaseTries);
+        deleteTries(mRevTries);
+        for (size_t wordLen = 0; wordLen < mPosMaps.size(); wordLen++)
+            delete mPosMaps[wordLen];
+        for (size_t wordLen = 0; wordLen < mRevPosMaps.size(); wordLen++)
+            delete mRevPosMaps[wordLen];
 #else
         deleteTries(mIdentTries);
         deleteTries(mCompactTries);
         deleteTries(mFreqTries);
 #endif
 #ifndef _MBCS
-        if (mWordMaps != NULL)
-            delete [] mWordMaps;
+        if (mWordArrays != NULL)
+            delete [] mWordArrays;
 #endif
     }
 
@@ -105,9 +126,44 @@ private:
         }
     }
 
-    template <typename MapT>    // Loads from the file only once; no re-loading after init.  Modifies rMaxWordLength.
-    static uint initFromSortedDictionaryFile(const char *fname, const MapT &charMap, WordTrie<MapT, TrixNode> *mTries[]
-    , WordMap *maps, uint minWordLength, uint maxWordLength); 
+    template <typename MapT>    // Loads the words only once; no re-loading after init.
+    static uint initFromWordList(const WordListFile& wordList, const MapT &charMap, WordTrie<MapT, RectNode> *mTries[]
+    , WordArray *arrays, uint minWordLength, uint maxWordLength, uint numThreads = 1, WordTrie<MapT, RectNode> *revTries[] = NULL); 
+
+    template <typename MapT>    // The lengths of words one thread loads into their tries (and word arrays)
+    struct TrieLoader
+    {
+        TrieLoader() : mWordList(NULL), mCharMap(NULL), mWordTries(NULL), mRevTries(NULL), mWordArrays(NULL), mWordsOfLength(NULL)
+            , mNumToLoad(0), mNumLoaded(0) { }
+        const WordListFile        * mWordList;
+        const MapT                * mCharMap;
+        WordTrie<MapT, RectNode> ** mWordTries;
+        WordTrie<MapT, RectNode> ** mRevTries;       // tries of the same words spelled backwards, or NULL
+        WordArray                 * mWordArrays;
+        const std::vector<uint>   * mWordsOfLength;  // indices into mWordList, by length
+        std::vector<uint>           mLengths;
+        uint                        mNumToLoad;
+        uint                        mNumLoaded;
+    };
+    template <typename MapT>
+    static void loadTries(void *pvLoader);
+
+    /** How many threads build the tries: one per processor, unless single-threaded. */
+    uint numLoadThreads() const
+    {
+        if (mSingleThreaded)
+            return 1;
+        SYSTEM_INFO sysinfo;
+        GetSystemInfo(&sysinfo);
+        int numProcessors = (int)sysinfo.dwNumberOfProcessors;
+        return numProcessors > 1 ? (uint)numProcessors : 1;
+    }
+
+    /** Print the words matching each of the comma-separated patterns, found in one pass per word length. */
+    int  matchPatterns(const char *patternList, const CodePointMap& codePoints) const;
+
+    /** Print the dictionary words nearest by edit distance to each of the comma-separated words. */
+    int  matchNearWords(const char *wordList, const CodePointMap& codePoints) const;
 
     static int nextWantWideTall(int& wide, int& tall, const int& minTall, const int& maxTall
         , const int& minArea, const int& maxArea, const int& maxWide, bool ascending);
@@ -115,26 +171,39 @@ private:
 private:    // data
 
 #if	USE_BASE_CHAR_MAP
-    WordTrie<CharMap, TrixNode> ** mBaseTries;    // pointer to array of tries, indexed by word length
+    WordTrie<CharMap, RectNode> ** mBaseTries;    // pointer to array of tries, indexed by word length
+    std::vector<CharPosMap *>      mPosMaps;      // the char map of each trie, by word length, if they are made of TryNodes
+    WordTrie<CharMap, RectNode> ** mRevTries;     // same words spelled backwards, with eOrientShapes, else NULL
+    std::vector<CharPosMap *>      mRevPosMaps;   // the char maps of mRevTries, if they are made of TryNodes
 #else
     WordTrie<IdentCharMap>		** mIdentTries;    // pointer to array of tries, indexed by word length
     WordTrie<CompactCharMap>	** mCompactTries;    // pointer to array of tries, indexed by word length
     WordTrie<FreqFirstCharMap>	** mFreqTries;    // pointer to array of tries, indexed by word length
 #endif
 
-    WordMap           * mWordMaps; // pointer to array of word maps, indexed by word length
+    WordArray         * mWordArrays; // pointer to array of word arrays, indexed by word length
 #ifdef _MBCS
-    WordMap             mWordMapsMem[64];   // FIXME TODO remove unless this really is an MSVC bug
+    WordArray           mWordArraysMem[64];   // FIXME TODO remove unless this really is an MSVC bug
 #endif
     uint                mNumWords;
     uint                mMinCharCount;	// The min char count used by CharFreqMap to make the mCharMap.  Publicly read-only.
     uint                mMinWordLength;
     uint                mMaxWordLength;
     int                 mVerbosity;   // 0=Report begin and end; 1=Report 1 find; 2=Report all finds & threads (default).
+    uint                mTimeBudget;  // Seconds allowed for the whole search (anytime mode), or 0 for no limit.
+    uint                mNumShufflers; // Number of randomized finders per shape, or 0 for the default finders.
+    uint                mNumProbes;   // Number of random probes per shape for estimating instead of searching, or 0.
+    uint                mNumSamples;  // Number of uniformly random rects to show per shape, with eCountByStates.
+    uint                mFrontierDepth; // Number of shallow rows the rect finders of each width share, or 0.
+    const char        * mResultsFile; // File of shapes decided by earlier runs, to skip them and add to, or NULL.
+    const char        * mPatterns;    // Comma-separated word patterns to match instead of searching, or NULL.
+    const char        * mNearWords;   // Comma-separated words to find the nearest dictionary words to instead of searching, or NULL.
+    const char        * mGridMask;    // File of a grid mask, or the name of a grid pattern, to fill instead of rects, or NULL.
+    RectOrientation     mOrientation; // Side to fill each rect from, with eOrientShapes: one for all, or the best for each shape.
 
     // instance options
     uint                mManagerFlags;
-    bool                mUseMaps;     
+    bool                mUseArrays;     
     bool                mSingleThreaded; 
     bool                mUseTracNodes;
 
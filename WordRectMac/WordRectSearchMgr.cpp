@@ -4,6 +4,7 @@
 
 #include "wordTypes.h"
 #include "wordPlatform.h"
+#include "wordRandom.h"
 
 #ifdef _MBCS	// Microsoft Compiler
 
@@ -37,14 +38,26 @@ static const int WAIT_TIMEOUT = 0;
 // project headers, including template class & method declarations:
 #include "WordRectSearchMgr.hpp"
 #include "CharFreqMap.hpp"
+#include "CodePointMap.hpp"
 #include "WordLatticeFinder.hpp"
 #include "WordWaffleFinder.hpp"
+#include "WordGridFinder.hpp"
+#include "WordRectAnytimeFinder.hpp"
+#include "WordRectShuffleFinder.hpp"
+#include "WordRectFinderFixed.hpp"
 
 // project template class & template method definitions:
 #include "WordRectFinder.cpp"
 #include "WordLatticeFinder.cpp"
 #include "WordWaffleFinder.cpp"
-#include "WordWaffleFinderSearchA.cpp"
+#include "WordGridFinder.cpp"
+#include "WordRectAnytimeFinder.cpp"
+#include "WordRectShuffleFinder.cpp"
+#include "WordRectFinderFixed.cpp"
+#include "WordRectEstimator.cpp"
+#include "WordRectCounter.cpp"
+#include "WordRectPruner.cpp"
+#include "WordRectFrontier.cpp"
 
 template <typename MapT>
 typename WordRectSearchMgr<MapT>::FinderThreadInfo *WordRectSearchMgr<MapT>::sFinders[sHardMaxFinders];
@@ -58,6 +71,14 @@ template <typename MapT>   int     WordRectSearchMgr<MapT>::sFoundArea        =
 template <typename MapT>   int	    WordRectSearchMgr<MapT>::sTrumpingArea     = 0;
 template <typename MapT>   int	    WordRectSearchMgr<MapT>::sMinimumArea      = 0;
 template <typename MapT>   bool    WordRectSearchMgr<MapT>::sAbortIfTrumped   = true;
+template <typename MapT>   int     WordRectSearchMgr<MapT>::sTimeBudget       = 0;
+template <typename MapT>   time_t  WordRectSearchMgr<MapT>::sDeadline         = 0;
+template <typename MapT>   int     WordRectSearchMgr<MapT>::sShapesLeft       = 0;
+template <typename MapT>   std::vector<typename WordRectSearchMgr<MapT>::ShapeReport> WordRectSearchMgr<MapT>::sShapeReports;
+template <typename MapT>   uint64  WordRectSearchMgr<MapT>::sTotalCounted     = 0;
+template <typename MapT>   uint64  WordRectSearchMgr<MapT>::sTotalSymCounted  = 0;
+template <typename MapT>   WordRectResults * WordRectSearchMgr<MapT>::sResults = NULL;
+template <typename MapT>   const char *      WordRectSearchMgr<MapT>::sResultKind = "rect";
 
 #ifndef _MBCS
 template <typename MapT>
@@ -72,6 +93,7 @@ template <typename MapT>
 int WordRectSearchMgr<MapT>::manageSearch(uint minArea, uint minTall, uint maxTall, uint maxArea, uint maxWordLength, uint numEach, uint numTot)
 {
     sMinimumArea = minArea;
+    mMaxWordLength = maxWordLength;
 
     if (maxTall > maxWordLength)
         maxTall = maxWordLength;
@@ -113,22 +135,58 @@ int WordRectSearchMgr<MapT>::manageSearch(uint minArea, uint minTall, uint maxTa
     char    ctimeBuf[ CTIME_SAFE_BUFSIZE ];
     ctime_safe(ctimeBuf, CTIME_SAFE_BUFSIZE, &sSearchStartTime );
     printf("Starting the search at %s\n", ctimeBuf);
+    if (sTimeBudget > 0) {
+        // In anytime mode, each finder gets a time slice from what is left of the budget,
+        // so we need to know how many shapes there are to split it among.
+        sDeadline = sSearchStartTime + sTimeBudget;
+        sShapesLeft = 0;
+        sShapeReports.clear();
+        for (int wide = -1, tall = -1; nextShape(wide, tall, minTall, maxTall, minArea, maxArea, maxWordLength); ) {
+            if ( ! (mOnlyOddDims && (wide % 2 == 0 || tall % 2 == 0)))
+                sShapesLeft += (mNumShufflers > 0 && findsRects() && !mCountOnly) ? mNumShufflers : 1;
+        }
+        printf("    Anytime mode: time budget %d seconds for %d shapes.\n", sTimeBudget, sShapesLeft);
+    }
     printf("    Hit Ctrl-C to see the word rectangle(s) in progress...\n\n");
+    if (mCountOnly) {
+        printf("    Counting mode: counting all word rects of each size%s.\n\n"
+            , (mFindLattices || mFindWaffles) ? " (not lattices or waffles, which are searched as usual)" : "");
+        sTotalCounted = sTotalSymCounted = 0;
+    }
+    sResultKind = mFindGrids ? mGridKind.c_str() : (mFindLattices ? "lattice" : (mFindWaffles ? "waffle" : "rect"));
+    if (mResultsFile != NULL) {
+        sResults = new WordRectResults(mResultsFile, fingerprintWords());
+        int numKnown = sResults->load();
+        if (numKnown < 0)
+            printf("    Results: could not read %s, so starting with none.\n\n", mResultsFile);
+        else
+            printf("    Results: %d %s shapes already known for dictionary %016llx in %s.\n\n"
+                , numKnown, sResultKind, sResults->getFingerprint(), mResultsFile);
+    }
     signal( SIGINT, sigintHandler);
 
     DWORD result, threadId;
+    std::map<int, WordRectFrontier<MapT> *> frontiers;     // by width, with -f; NULL if too big to keep
     int  wantWide = -1, wantTall = -1;
-    while( nextWantWideTall(wantWide, wantTall, minTall, maxTall, minArea, maxArea, maxWordLength, mAscending) ) {
+    while( nextShape(wantWide, wantTall, minTall, maxTall, minArea, maxArea, maxWordLength) ) {
 
         if (mOnlyOddDims && (wantWide % 2 == 0 || wantTall % 2 == 0))
             continue;
 
+        if (sTimeBudget > 0 && time(NULL) >= sDeadline) {
+            printf("Stop   %2d * %2d because the time budget of %d seconds is used up\n", wantWide, wantTall, sTimeBudget);
+            break;
+        }
+
         int wantArea = wantWide*wantTall;
         if (wantArea <= getTrumpingArea()) {
             printf("Skip   %2d * %2d because %3d <= %3d (area already found)\n", wantWide, wantTall, wantArea, getTrumpingArea());
             continue;
         }
 
+        if (sResults != NULL && useKnownResult(wantWide, wantTall))
+            continue;
+
         // Create a new worker thread.  We don't try to control or even observe the 
         // worker threads here in this loop.  Just create one and let it synchronize itself
         // with any that are already running.  If the max number of worker threads are already
@@ -139,40 +197,89 @@ int WordRectSearchMgr<MapT>::manageSearch(uint minArea, uint minTall, uint maxTa
         // that we create here and pass in to CreateThread.  (That's easier than making a WRF-factory
         // just for the thread func!)
 
-        assert(mWordTries);
-        WordRectFinder<MapT> *pWRF = NULL;
-        if (mFindLattices) {
-            pWRF = new WordLatticeFinder<MapT>(mWordTries, mWordMaps, wantWide, wantTall, numEach, sFinderOptions);
-        } else if (mFindWaffles) {
-            pWRF = new WordWaffleFinder<MapT>(mWordTries, mWordMaps, wantWide, wantTall, numEach, sFinderOptions);
-        } else {
-            pWRF = new WordRectFinder<MapT>(mWordTries, mWordMaps, wantWide, wantTall, mNumEach, sFinderOptions);
-        }
-#ifdef _MBCS
-        HANDLE threadHandle = CreateThread   ( NULL, 0, (LPTHREAD_START_ROUTINE)finderThreadFunc, pWRF, 0, &threadId );
-#else
-        HANDLE threadHandle = CreateThread<MapT>( NULL, 0, (LPTHREAD_START_ROUTINE)finderThreadFunc, pWRF, 0, &threadId );
-#endif
-        if (threadHandle == INVALID_HANDLE_VALUE) {
-            delete pWRF;
-            printf("\n    CreateThread failed for %d x %d finder!  Aborting.\n", wantWide, wantTall);
-            return -4;
-        }
-        pWRF = NULL;    // Forget we ever knew (or newed) this pointer!   ;p
-
-        // We don't strictly need to wait for this thread to start before initializing the next
-        // one in the loop, because we are not initializing these threads using pointers to 
-        // local memory that might change between the time the thread is created and the time
-        // it actually starts processing its function arguments.  (Just calling Sleep(1) would
-        // *probably* prevent such slippage.  But it's nice to make sure the threads start in 
-        // the order they are created here, and not to create a whole lot of them before we know
-        // they are needed, or that will just get aborted anyway.  
-        // So we wait for the child thread to set this event, then reset it:
-        result = WaitForSingleObject(WordRectSearchExec::ghThreadStartedEvent, INFINITE); 
-        if (result == WAIT_FAILED) {
-            printf("WaitForSingleObject failed on the start-one-finder-at-a-time event; error: %d  continuing\n", GetLastError());
+        // With randomized finders, start several on each shape, each with its own seed.
+        int numPerShape = (mNumShufflers > 0 && findsRects() && !mCountOnly) ? mNumShufflers : 1;
+        for (int shuffler = 0; shuffler < numPerShape; shuffler++) {
+            assert(mWordTries);
+            // With -R, plain finders search the shape turned so that they fill it from another side.
+            bool isPlain = findsRects() && (mCountOnly || (mNumShufflers == 0 && sTimeBudget == 0));
+            RectOrientation orient = (isPlain && !(sFinderOptions & WordRectSearchExec::eUseArrays)) ? chooseOrientation(wantWide, wantTall) : eTopRowFirst;
+            bool transposed = orient == eLeftColFirst || orient == eRightColFirst;
+            WordTrie<MapT, RectNode> **turnedTries = (orient == eBottomRowFirst || orient == eRightColFirst) ? mRevTries : mWordTries;
+            int  turnedWide = transposed ? wantTall : wantWide;
+            int  turnedTall = transposed ? wantWide : wantTall;
+
+            // With -p, each rect finder searches its own tries, pruned for its shape, and deletes them when done.
+            WordRectPruner<MapT> *pruner = (mPruneShapes && findsRects()) ? newPruner(turnedTries, turnedWide, turnedTall) : NULL;
+            WordTrie<MapT, RectNode> **wordTries = pruner != NULL ? pruner->getTries() : turnedTries;
+            WordRectFinder<MapT> *pWRF = NULL;
+            if (mFindGrids) {
+                pWRF = newGridFinder(wantWide, wantTall, mNumEach);
+                if (pWRF == NULL) {
+                    printf("Skip   %2d * %2d because its grid cannot be filled\n", wantWide, wantTall);
+                    break;
+                }
+                pWRF->setCountOnly(mCountOnly);
+            } else if (mFindLattices) {
+                pWRF = new WordLatticeFinder<MapT>(mWordTries, mWordArrays, wantWide, wantTall, numEach, sFinderOptions);
+            } else if (mFindWaffles) {
+                pWRF = new WordWaffleFinder<MapT>(mWordTries, mWordArrays, wantWide, wantTall, numEach, sFinderOptions);
+            } else if (mCountOnly) {
+                pWRF = newRectFinder(wordTries, turnedWide, turnedTall, mNumEach);
+                pWRF->setCountOnly(true);
+            } else if (mNumShufflers > 0) {
+                uint64 seed = WordRandom::shapeSeed(wantWide, wantTall, shuffler + 1);
+                pWRF = new WordRectShuffleFinder<MapT>(wordTries, mWordArrays, wantWide, wantTall, mNumEach, sFinderOptions, seed);
+            } else if (sTimeBudget > 0) {
+                pWRF = new WordRectAnytimeFinder<MapT>(wordTries, mWordArrays, wantWide, wantTall, mNumEach, sFinderOptions);
+            } else {
+                pWRF = newRectFinder(wordTries, turnedWide, turnedTall, mNumEach);
+            }
+            if (orient != eTopRowFirst)
+                pWRF->setOrientation(orient, mWordTries);
+            if (pruner != NULL) {
+                pruner->handOffTo(pWRF);
+                delete pruner;
+            }
+            // With -f, plain finders start from the shallow rows shared by all the heights of their width.
+            if (mFrontierDepth > 0 && isPlain && orient == eTopRowFirst && wantTall > mFrontierDepth) {
+                if (frontiers.find(wantWide) == frontiers.end()) {
+                    WordRectFrontier<MapT> *frontier = newFrontier(wantWide, minTall, maxTall, minArea, maxArea);
+                    if (frontier != NULL && ! frontier->isComplete()) {
+                        delete frontier;
+                        frontier = NULL;
+                    }
+                    frontiers[wantWide] = frontier;
+                }
+                if (frontiers[wantWide] != NULL)
+                    pWRF->setFrontier(frontiers[wantWide]);
+            }
+    #ifdef _MBCS
+            HANDLE threadHandle = CreateThread   ( NULL, 0, (LPTHREAD_START_ROUTINE)finderThreadFunc, pWRF, 0, &threadId );
+    #else
+            HANDLE threadHandle = CreateThread<MapT>( NULL, 0, (LPTHREAD_START_ROUTINE)finderThreadFunc, pWRF, 0, &threadId );
+    #endif
+            if (threadHandle == INVALID_HANDLE_VALUE) {
+                delete pWRF;
+                printf("\n    CreateThread failed for %d x %d finder!  Aborting.\n", wantWide, wantTall);
+                return -4;
+            }
+            pWRF = NULL;    // Forget we ever knew (or newed) this pointer!   ;p
+
+            // We don't strictly need to wait for this thread to start before initializing the next
+            // one in the loop, because we are not initializing these threads using pointers to 
+            // local memory that might change between the time the thread is created and the time
+            // it actually starts processing its function arguments.  (Just calling Sleep(1) would
+            // *probably* prevent such slippage.  But it's nice to make sure the threads start in 
+            // the order they are created here, and not to create a whole lot of them before we know
+            // they are needed, or that will just get aborted anyway.  
+            // So we wait for the child thread to set this event, then reset it:
+            result = WaitForSingleObject(WordRectSearchExec::ghThreadStartedEvent, INFINITE); 
+            if (result == WAIT_FAILED) {
+                printf("WaitForSingleObject failed on the start-one-finder-at-a-time event; error: %d  continuing\n", GetLastError());
+            }
+            (void)ResetEvent(WordRectSearchExec::ghThreadStartedEvent);                         // ignore the return value
         }
-        (void)ResetEvent(WordRectSearchExec::ghThreadStartedEvent);                         // ignore the return value
     }
 
     // Wait for all remaining finder threads to end.  If the sigint handler happens to be active,
@@ -184,11 +291,21 @@ int WordRectSearchMgr<MapT>::manageSearch(uint minArea, uint minTall, uint maxTa
     }
     LeaveCriticalSection(&WordRectSearchExec::gcsFinderSection);
     result = WaitForMultipleObjects(sNumFinders, finderThreadHandles, true, INFINITE);
+    for (typename std::map<int, WordRectFrontier<MapT> *>::iterator it = frontiers.begin(); it != frontiers.end(); ++it)
+        delete it->second;
+    delete sResults;
+    sResults = NULL;
 
     time_t timeEnd = time( &timeEnd );
     ctime_safe(ctimeBuf, CTIME_SAFE_BUFSIZE, &timeEnd );
     printf("\nFinished the search %s", ctimeBuf);
     printf("Elapsed time: %d seconds\n", (int)(timeEnd - sSearchStartTime) );
+    if (sTimeBudget > 0) {
+        printShapeReports(timeEnd);
+    }
+    if (mCountOnly) {
+        printf("Counted %llu word rects in all, including %llu symmetric squares.\n", sTotalCounted, sTotalSymCounted);
+    }
 
     CloseHandle(WordRectSearchExec::ghMaxThreadsSemaphore);
     CloseHandle(WordRectSearchExec::ghThreadStartedEvent);
@@ -197,12 +314,339 @@ int WordRectSearchMgr<MapT>::manageSearch(uint minArea, uint minTall, uint maxTa
 }
 
 
+template <typename MapT> 
+void WordRectSearchMgr<MapT>::estimateShape(int wide, int tall, uint numProbes, typename WordRectEstimator<MapT>::Estimate& est) const
+{
+    uint64 seed = WordRandom::shapeSeed(wide, tall);
+    WordRectPruner<MapT> *pruner = mPruneShapes ? newPruner(mWordTries, wide, tall) : NULL;
+    WordRectEstimator<MapT> estimator(pruner != NULL ? pruner->getTries() : mWordTries, wide, tall, seed);
+    estimator.estimate(numProbes, est);
+    delete pruner;
+}
+
+template <typename MapT> 
+int WordRectSearchMgr<MapT>::estimateSearch(uint minArea, uint minTall, uint maxTall, uint maxArea, uint maxWordLength, uint numProbes)
+{
+    mMaxWordLength = maxWordLength;
+    if (maxTall > maxWordLength)
+        maxTall = maxWordLength;
+    if (maxArea > maxWordLength*maxWordLength)
+        maxArea = maxWordLength*maxWordLength;
+
+    printf("Estimating search tree sizes with %d random probes per shape (95%% intervals):\n", numProbes);
+    printf("  Shape      Nodes   (low - high)              Rects    Seconds (low - high)          Max rows\n");
+    int numShapes = 0;
+    int  wantWide = -1, wantTall = -1;
+    while( nextWantWideTall(wantWide, wantTall, minTall, maxTall, minArea, maxArea, maxWordLength, mAscending) ) {
+        if (mOnlyOddDims && (wantWide % 2 == 0 || wantTall % 2 == 0))
+            continue;
+        typename WordRectEstimator<MapT>::Estimate est;
+        estimateShape(wantWide, wantTall, numProbes, est);
+        printf("EST %2d * %2d  %9.3g (%9.3g - %9.3g)  %9.3g  %9.3g (%9.3g - %9.3g)  %2d of %2d\n"
+            , wantWide, wantTall, est.mNodes, est.mNodesLo, est.mNodesHi, est.mRects
+            , est.mSeconds, est.mSecondsLo, est.mSecondsHi, est.mMaxDepth, wantTall);
+        ++numShapes;
+    }
+    return numShapes;
+}
+
+template <typename MapT>
+int WordRectSearchMgr<MapT>::setGridMask(const char *spec, uint maxWordLength)
+{
+    mFindGrids   = true;
+    mGridPattern = NULL;
+    mGridRows.clear();
+    std::vector<std::string> rows;
+    if (WordGrid::makeMask(spec, 2, 2, rows)) {
+        mGridPattern = spec;
+        mGridKind    = std::string("grid-") + spec;
+        return 0;
+    }
+    if (WordGrid::readMask(spec, mGridRows) < 0) {
+        printf("Could not read the grid mask file %s\n", spec);
+        return -1;
+    }
+    WordGrid grid;
+    int numSlots = grid.init(mGridRows, maxWordLength);
+    if (numSlots < 0)
+        return -1;
+    if ((uint)grid.getWide() > maxWordLength || (uint)grid.getTall() > maxWordLength) {
+        printf("The %d * %d grid in %s is bigger than the longest words loaded (%d).\n", grid.getWide(), grid.getTall(), spec, maxWordLength);
+        return -1;
+    }
+    // Grids of one shape but different masks must not share results, so the kind includes a hash of the mask.
+    uint64 hash = WordRectResults::sFnvOffset;
+    for (size_t row = 0; row < mGridRows.size(); row++) {
+        hash = WordRectResults::fnv1a(mGridRows[row].c_str(), hash);
+        hash = WordRectResults::fnv1a("\n", hash);
+    }
+    char kind[32];
+    sprintf(kind, "grid-%016llx", hash);
+    mGridKind = kind;
+    if (sVerbosity > 0) {
+        printf("Grid mask from %s, %d * %d with %d words:\n", spec, grid.getWide(), grid.getTall(), numSlots);
+        grid.printMask();
+    }
+    return numSlots;
+}
+
+template <typename MapT>
+WordRectFinder<MapT> * WordRectSearchMgr<MapT>::newGridFinder(int wide, int tall, uint numToFind) const
+{
+    WordGrid *grid = new WordGrid();
+    int numSlots = -1;
+    if (mGridPattern == NULL) {
+        numSlots = grid->init(mGridRows, mMaxWordLength);
+    } else {
+        std::vector<std::string> rows;
+        WordGrid::makeMask(mGridPattern, wide, tall, rows);
+        numSlots = grid->init(rows, mMaxWordLength);
+    }
+    if (numSlots < 0) {
+        delete grid;
+        return NULL;
+    }
+    return new WordGridFinder<MapT>(mWordTries, mWordArrays, grid, numToFind, sFinderOptions);
+}
+
+template <typename MapT> 
+WordRectFinder<MapT> * WordRectSearchMgr<MapT>::newRectFinder(WordTrie<MapT, RectNode> *wordTries[], int wide, int tall, uint numToFind) const
+{
+    if (sFinderOptions & WordRectSearchExec::eUseArrays)
+        return new WordRectFinder<MapT>(wordTries, mWordArrays, wide, tall, numToFind, sFinderOptions);
+
+#define NEW_FIXED_FINDER(W) case W: return new WordRectFinderFixed<MapT, W>(wordTries, mWordArrays, tall, numToFind, sFinderOptions)
+    switch (wide) {
+        NEW_FIXED_FINDER(2);    NEW_FIXED_FINDER(3);    NEW_FIXED_FINDER(4);    NEW_FIXED_FINDER(5);
+        NEW_FIXED_FINDER(6);    NEW_FIXED_FINDER(7);    NEW_FIXED_FINDER(8);    NEW_FIXED_FINDER(9);
+        NEW_FIXED_FINDER(10);   NEW_FIXED_FINDER(11);   NEW_FIXED_FINDER(12);   NEW_FIXED_FINDER(13);
+        NEW_FIXED_FINDER(14);   NEW_FIXED_FINDER(15);   NEW_FIXED_FINDER(16);
+    default:
+        return new WordRectFinder<MapT>(wordTries, mWordArrays, wide, tall, numToFind, sFinderOptions);
+    }
+#undef  NEW_FIXED_FINDER
+}
+
+template <typename MapT> 
+WordRectPruner<MapT> * WordRectSearchMgr<MapT>::newPruner(WordTrie<MapT, RectNode> *wordTries[], int wide, int tall) const
+{
+    WordRectPruner<MapT> *pruner = new WordRectPruner<MapT>(wordTries, mMaxWordLength, wide, tall);
+    if (sVerbosity > 1) {
+        printf("Prune  %2d * %2d: %u of %u row words, %u of %u column words, %u of %u row nodes, %d passes (%.2f seconds)\n"
+            , wide, tall, pruner->getNumRowWords(), pruner->getNumBaseRowWords(), pruner->getNumColWords(), pruner->getNumBaseColWords()
+            , pruner->getNumRowNodes(), pruner->getNumBaseRowNodes(), pruner->getNumPasses(), pruner->getSeconds());
+    }
+    return pruner;
+}
+
+/**
+* Rare letters near the ends of words make a rect's last rows and columns the most
+* constrained, so filling it from the bottom or right may prune far more than from the top.
+* Knuth's estimate of each side's search tree says which is smallest.  For a square, only
+* the top and bottom differ: filling it from the left is the same search as from the top.
+*/
+template <typename MapT> 
+RectOrientation WordRectSearchMgr<MapT>::chooseOrientation(int wide, int tall) const
+{
+    if (mRevTries == NULL || mOrientation != eBestSideFirst)
+        return mOrientation;
+    static const char *sideNames[eNumSides] = { "top", "bottom", "left", "right" };
+    static const uint  numProbes = 200;
+    uint64 seed = WordRandom::shapeSeed(wide, tall);
+    RectOrientation best = eTopRowFirst;
+    double bestNodes = 0.0;
+    int numSides = wide == tall ? 2 : eNumSides;
+    for (int side = 0; side < numSides; side++) {
+        bool transposed = side == eLeftColFirst || side == eRightColFirst;
+        WordTrie<MapT, RectNode> **tries = (side == eBottomRowFirst || side == eRightColFirst) ? mRevTries : mWordTries;
+        WordRectEstimator<MapT> estimator(tries, transposed ? tall : wide, transposed ? wide : tall, seed);
+        typename WordRectEstimator<MapT>::Estimate est;
+        estimator.estimate(numProbes, est);
+        if (sVerbosity > 2)
+            printf("Side   %2d * %2d from the %-6s %9.3g nodes\n", wide, tall, sideNames[side], est.mNodes);
+        if (side == 0 || est.mNodes < bestNodes) {
+            best = (RectOrientation)side;
+            bestNodes = est.mNodes;
+        }
+    }
+    if (sVerbosity > 1)
+        printf("Side   %2d * %2d: fill from the %s (%.3g nodes estimated)\n", wide, tall, sideNames[best], bestNodes);
+    return best;
+}
+
+template <typename MapT> 
+WordRectFrontier<MapT> * WordRectSearchMgr<MapT>::newFrontier(int wide, int minTall, int maxTall, int minArea, int maxArea) const
+{
+    // Only the heights that this width will be searched with, as in nextWantWideTall.
+    int lowTall = (minArea + wide - 1) / wide;
+    if (lowTall < minTall)
+        lowTall = minTall;
+    int highTall = maxArea / wide;
+    if (highTall > maxTall)
+        highTall = maxTall;
+    if (highTall > wide)
+        highTall = wide;
+    if (lowTall <= mFrontierDepth)
+        lowTall  = mFrontierDepth + 1;
+    if (lowTall >= highTall)
+        return NULL;                            // nothing to share with only one height
+    WordRectFrontier<MapT> *frontier = new WordRectFrontier<MapT>(mWordTries, wide, mFrontierDepth, lowTall, highTall);
+    if (sVerbosity > 1) {
+        if (frontier->isComplete())
+            printf("Front  %2d * %d: %u blocks of rows for heights %d to %d, from %u column stems (%.2f seconds)\n"
+                , wide, mFrontierDepth, frontier->getNumBlocks(), lowTall, highTall, frontier->getNumStems(), frontier->getSeconds());
+        else
+            printf("Front  %2d * %d: more than %u blocks of rows, so not used (%.2f seconds)\n"
+                , wide, mFrontierDepth, WordRectFrontier<MapT>::sMaxBlocks, frontier->getSeconds());
+    }
+    return frontier;
+}
+
+template <typename MapT> 
+uint64 WordRectSearchMgr<MapT>::fingerprintWords() const
+{
+    uint64 hash = WordRectResults::sFnvOffset;
+    for (uint wordLen = 1; wordLen <= mMaxWordLength; wordLen++) {
+        if (mWordTries[wordLen] == NULL)
+            continue;
+        for (const RectNode *node = mWordTries[wordLen]->getFirstWordNode(); node != NULL; ) {
+            hash = WordRectResults::fnv1a(node->getStem(), hash);
+            hash = WordRectResults::fnv1a("\n", hash);
+            const RectNode *nextStem = node->getNextStemNode();
+            node = nextStem != NULL ? nextStem->getFirstWordNode() : NULL;
+        }
+    }
+    return hash;
+}
+
+/**
+* If an earlier run already decided this shape, report what it found instead of searching
+* again, and return true.  A proof of no rects decides it for any search; rects found decide
+* it unless this search wants more of them than were found (or all of them, and the earlier
+* search stopped short).  Counting needs every rect, so it can only skip the empty shapes.
+*/
+template <typename MapT> 
+bool WordRectSearchMgr<MapT>::useKnownResult(int wide, int tall)
+{
+    // Finder threads record their results, and update the areas and the shapes left, in this section, too.
+    EnterCriticalSection(&WordRectSearchExec::gcsFinderSection);
+    const WordRectResults::Result *known = sResults->find(sResultKind, wide, tall);
+    bool useKnown = known != NULL;
+    if (known == NULL) {
+        // Not known, so search it.
+    } else if (known->mStatus == WordRectResults::eNone) {
+        if (sVerbosity > 0)
+            printf("Known  %2d * %2d: no rects (proved in %.2f seconds)\n", wide, tall, known->mSeconds);
+    } else if (mCountOnly) {
+        useKnown = false;
+    } else if (known->mStatus == WordRectResults::eSome && (mNumEach == 0 || (uint)known->mNumFound < mNumEach)) {
+        useKnown = false;
+    } else {
+        if (sVerbosity > 0) {
+            printf("Known  %2d * %2d: %s %d rects (found in %.2f seconds)\n", wide, tall
+                , known->mStatus == WordRectResults::eAll ? "all" : "at least", known->mNumFound, known->mSeconds);
+            for (size_t row = 0; row < known->mRows.size(); row++) {
+                for (const char *pc = known->mRows[row].c_str(); *pc != '\0'; pc++)
+                    printf(" %s", CodePointMap::getText(*pc));
+                printf("\n");
+            }
+        }
+        // Same as finding it now, as far as any smaller shapes are concerned.
+        int area = wide*tall;
+        if (sFoundArea < area) {
+            sFoundArea = area;
+            if (sAbortIfTrumped)
+                sTrumpingArea = sFoundArea;
+        }
+    }
+    if (useKnown && sTimeBudget > 0)
+        sShapesLeft -= (mNumShufflers > 0 && findsRects() && !mCountOnly) ? mNumShufflers : 1;
+    LeaveCriticalSection(&WordRectSearchExec::gcsFinderSection);
+    return useKnown;
+}
+
+/**
+* Keep what this finder decided about its shape, if anything: not if it was cancelled,
+* aborted, or timed out.  Only rect rows are kept, since lattices and waffles print
+* from their own column words.
+*/
+template <typename MapT> 
+void WordRectSearchMgr<MapT>::recordResult(const WordRectFinder<MapT> *pWRF)
+{
+    typename WordRectFinder<MapT>::FinderState state = pWRF->getState();
+    if (state == WordRectFinder<MapT>::eReady || state == WordRectFinder<MapT>::eAborted || state == WordRectFinder<MapT>::eTimedOut)
+        return;
+    WordRectResults::Result result;
+    result.mSeconds  = pWRF->getSearchSeconds();
+    result.mNumFound = pWRF->getNumFound();
+    if (pWRF->getCountOnly()) {
+        if (pWRF->getNumCounted() > 0)
+            return;                             // counts are not kept, only proofs that there are none
+        result.mStatus = WordRectResults::eNone;
+    } else if (result.mNumFound == 0) {
+        result.mStatus = WordRectResults::eNone;
+    } else {
+        bool stoppedEarly = pWRF->getNumToFind() > 0 && result.mNumFound >= pWRF->getNumToFind();
+        result.mStatus = stoppedEarly ? WordRectResults::eSome : WordRectResults::eAll;
+        if (strcmp(sResultKind, "rect") == 0) {
+            const char **rows = pWRF->getBestRows();
+            for (int row = 0; row < pWRF->getRectTall(); row++)
+                result.mRows.push_back(rows[row]);
+        }
+    }
+    if ( ! sResults->record(sResultKind, pWRF->getRectWide(), pWRF->getRectTall(), result))
+        printf("Could not add the %d * %d result to %s\n", pWRF->getRectWide(), pWRF->getRectTall(), sResults->getFileName());
+}
+
+template <typename MapT> 
+int WordRectSearchMgr<MapT>::countSearch(uint minArea, uint minTall, uint maxTall, uint maxArea, uint maxWordLength, uint numSamples)
+{
+    if (maxTall > (uint)WordRectCounter<MapT>::sMaxTall) {
+        printf("Transfer-matrix counting handles heights up to %d, not %d.\n", WordRectCounter<MapT>::sMaxTall, maxTall);
+        maxTall = WordRectCounter<MapT>::sMaxTall;
+    }
+    if (maxArea > maxWordLength*maxTall)
+        maxArea = maxWordLength*maxTall;
+    mMaxWordLength = maxWordLength;
+
+    uint64 total = 0;
+    int numShapes = 0;
+    int  wantWide = -1, wantTall = -1;
+    while( nextWantWideTall(wantWide, wantTall, minTall, maxTall, minArea, maxArea, maxWordLength, mAscending) ) {
+        if (mOnlyOddDims && (wantWide % 2 == 0 || wantTall % 2 == 0))
+            continue;
+        clock_t clockBeg = clock();
+        WordRectPruner<MapT> *pruner = mPruneShapes ? newPruner(mWordTries, wantWide, wantTall) : NULL;
+        WordRectCounter<MapT> counter(pruner != NULL ? pruner->getTries() : mWordTries, wantWide, wantTall);
+        uint64 count = counter.count();
+        double seconds = (double)(clock() - clockBeg) / CLOCKS_PER_SEC;
+        printf("COUNT  %2d * %2d: %llu word rects (%u column classes, %u states, %.2f seconds)\n"
+            , wantWide, wantTall, count, counter.getNumClasses(), counter.getNumStates(), seconds);
+        total += count;
+        ++numShapes;
+
+        WordRandom random(WordRandom::shapeSeed(wantWide, wantTall));
+        const char *rowWords[WordRectCounter<MapT>::sMaxTall];
+        for (uint j = 0; j < numSamples && counter.sample(random, rowWords); j++) {
+            printf("Random %2d * %2d word rect %u of %u:\n", wantWide, wantTall, j + 1, numSamples);
+            for (int row = 0; row < wantTall; row++) {
+                for (int col = 0; col < wantWide; col++)
+                    printf(" %s", CodePointMap::getText(rowWords[row][col]));
+                printf("\n");
+            }
+        }
+        delete pruner;
+    }
+    printf("Counted %llu word rects in all, over %d sizes.\n", total, numShapes);
+    return numShapes;
+}
+
 template <typename MapT> 
 unsigned long WordRectSearchMgr<MapT>::finderThreadFunc( void *pvArgs )
 {
     WordRectFinder<MapT> *pWRF = static_cast<WordRectFinder<MapT> *>(pvArgs);
-    int   wantWide  =  pWRF->getWide();
-    int   wantTall  =  pWRF->getTall();
+    int   wantWide  =  pWRF->getRectWide();
+    int   wantTall  =  pWRF->getRectTall();
 
     // Use the passed-in pWRF to construct our FinderThreadInfo on the thread-local stack.
     // When this FTI falls out of scope, its destructor will delete the pWRF.
@@ -263,12 +707,23 @@ unsigned long WordRectSearchMgr<MapT>::finderThreadFunc( void *pvArgs )
         assert(sFinders[sNumFinders] == NULL);
         sFinders[sNumFinders] = &myFTI;    // Add our info to end slot, which should already be empty.
         ++sNumFinders;
+
+        if (sTimeBudget > 0) {
+            // Anytime mode: take an equal share of the time left for the shapes left, times the
+            // number of threads, because the unused part of any share goes back into the pool.
+            time_t timeLeft = sDeadline - timeNow;
+            time_t slice = timeLeft * sSoftMaxFinders / (sShapesLeft > 0 ? sShapesLeft : 1);
+            if (slice < 1)
+                slice = 1;
+            pWRF->setDeadline(timeNow + slice < sDeadline ? timeNow + slice : sDeadline);
+        }
     } else {
         if (sVerbosity) {
             printf("CANCEL %2d * %2d because %3d <= %3d (thread %2d dying after 0 seconds)\n"
                 , wantWide, wantTall, wantArea, foundArea, sNumFinders);
         }
     }
+    --sShapesLeft;
     // We finished initializing and registering our thread info in the managers' table 
     // (if this finder was still relevant), so now we can leave the CS and set the Event.
     // Other finder threads may be waiting to begin or end, and their doing so could affect 
@@ -313,8 +768,13 @@ unsigned long WordRectSearchMgr<MapT>::finderThreadFunc( void *pvArgs )
             int numFound = pWRF->getNumFound();
 #define MSG_LEN 64
             char statusMsg[MSG_LEN];
+            statusMsg[0] = '\0';
             if (pWRF->getState() == WordRectFinder<MapT>::eAborted && sVerbosity > 1) {
                 sprintf_safe(statusMsg, MSG_LEN, "Aborted, %d rects, because %d <= %d.", numFound, -area, sTrumpingArea);
+            } else if (pWRF->getCountOnly() && pWRF->getState() != WordRectFinder<MapT>::eReady) {
+                sprintf_safe(statusMsg, MSG_LEN, "Counted %llu rects (%llu symmetric).", pWRF->getNumCounted(), pWRF->getNumSymCounted());
+            } else if (pWRF->getState() == WordRectFinder<MapT>::eTimedOut) {
+                sprintf_safe(statusMsg, MSG_LEN, "Timed out with %d rects, %d of %d rows.", numFound, pWRF->getMaxTall(), wantTall);
             } else if (numFound > 0) {
                 sprintf_safe(statusMsg, MSG_LEN, "Success: Finished with %d rects.", numFound);
             } else if (sVerbosity > 1) {
@@ -322,10 +782,34 @@ unsigned long WordRectSearchMgr<MapT>::finderThreadFunc( void *pvArgs )
             }
             printf("End    %2d * %2d (%d) at %d seconds; %s\n"
                 , wantWide, wantTall, myFTI.mFinderIdx, elapsedSeconds, statusMsg);
+            if (sVerbosity > 1 && pWRF->getNumNodes() > 0) {
+                double seconds = pWRF->getSearchSeconds();
+                printf("Nodes  %2d * %2d: %llu in %.2f seconds, %.3g per second\n", wantWide, wantTall
+                    , pWRF->getNumNodes(), seconds, seconds > 0.0 ? pWRF->getNumNodes() / seconds : 0.0);
+            }
 
             // If at least one was found and not already shown, show it now
-            if (area > 0) {
+            if (area > 0 && ! pWRF->getCountOnly()) {
                 pWRF->printWordRectLastFound(timeNow);   // show latest complete word rect
+            } else if (pWRF->getState() == WordRectFinder<MapT>::eTimedOut && pWRF->getMaxTall() > 0) {
+                printf("DEEPEST %2d * %2d partial rect (thread %d):\n", wantWide, wantTall, myFTI.mFinderIdx);
+                pWRF->printWordRows(pWRF->getBestRows(), pWRF->getMaxTall());
+            }
+        }
+        if (doRegister && sTimeBudget > 0) {
+            recordShapeReport(pWRF);
+        }
+        if (doRegister && sResults != NULL) {
+            recordResult(pWRF);
+        }
+        if (pWRF->getCountOnly()) {
+            sTotalCounted    += pWRF->getNumCounted();
+            sTotalSymCounted += pWRF->getNumSymCounted();
+            if (sVerbosity > 2 && pWRF->getOrientation() == eTopRowFirst) {    // else the first rows are not the rect's
+                const WordCounts& counts = pWRF->getFirstWordCounts();
+                char text[CodePointMap::sMaxTextLen * sMaxWordLength];
+                for (size_t j = 0; j < counts.size(); j++)
+                    printf("  %s %llu\n", CodePointMap::decode(counts[j].first, text, sizeof(text)), counts[j].second);
             }
         }
         if (doRegister) {   // We did register, so now we must unregister.
@@ -393,7 +877,7 @@ void WordRectSearchMgr<MapT>::sigintHandler ( int sig )
                 } else {
                     // The finder thread was signaled, or the wait failed
                     if (sVerbosity) {
-                        printf("Thread info not found for %d x %d finder...\n", pWRF->getWide(), pWRF->getTall());
+                        printf("Thread info not found for %d x %d finder...\n", pWRF->getRectWide(), pWRF->getRectTall());
                     }
                 }
             }
@@ -410,6 +894,75 @@ void WordRectSearchMgr<MapT>::sigintHandler ( int sig )
 }
 
 
+/** Save what the finder got, while it's still alive.  Call only inside the critical section. */
+template <typename MapT> 
+void WordRectSearchMgr<MapT>::recordShapeReport(const WordRectFinder<MapT> *pWRF)
+{
+    ShapeReport report;
+    report.mWide     = pWRF->getWide();
+    report.mTall     = pWRF->getTall();
+    report.mMaxTall  = pWRF->getMaxTall();
+    report.mNumFound = pWRF->getNumFound();
+    report.mState    = pWRF->getState();
+    const char **rows = pWRF->getBestRows();
+    for (int row = 0; row < report.mMaxTall; ++row)
+        report.mRows.push_back(rows[row]);
+    sShapeReports.push_back(report);
+}
+
+/** Anytime mode summary: the largest complete rect found, and the deepest partial rect for each other shape. */
+template <typename MapT> 
+void WordRectSearchMgr<MapT>::printShapeReports(time_t timeNow)
+{
+    const ShapeReport *best = NULL;
+    for (size_t j = 0; j < sShapeReports.size(); j++) {
+        const ShapeReport& rep = sShapeReports[j];
+        if (rep.mNumFound > 0 && (best == NULL || best->mWide*best->mTall < rep.mWide*rep.mTall))
+            best = &rep;
+    }
+    printf("\nAnytime summary (%d shapes tried in %d of %d seconds):\n"
+        , (int)sShapeReports.size(), (int)(timeNow - sSearchStartTime), sTimeBudget);
+    if (best != NULL) {
+        printf("LARGEST %2d * %2d Word Rect, area %3d:\n", best->mWide, best->mTall, best->mWide*best->mTall);
+        for (int row = 0; row < best->mMaxTall; row++) {
+            for (const char *pc = best->mRows[row].c_str(); *pc != '\0'; pc++)
+                printf(" %s", CodePointMap::getText(*pc));
+            printf("\n");
+        }
+    } else {
+        printf("No complete word rect found.\n");
+    }
+    for (size_t j = 0; j < sShapeReports.size(); j++) {
+        const ShapeReport& rep = sShapeReports[j];
+        if (rep.mNumFound > 0) {
+            printf("  %2d * %2d: found %d\n", rep.mWide, rep.mTall, rep.mNumFound);
+            continue;
+        }
+        printf("  %2d * %2d: deepest %d of %d rows (%s)\n", rep.mWide, rep.mTall, rep.mMaxTall, rep.mTall
+            , rep.mState == WordRectFinder<MapT>::eTimedOut ? "timed out"
+            : rep.mState == WordRectFinder<MapT>::eAborted ? "aborted" : "exhausted");
+        for (int row = 0; row < rep.mMaxTall; row++) {
+            printf("   ");
+            for (const char *pc = rep.mRows[row].c_str(); *pc != '\0'; pc++)
+                printf(" %s", CodePointMap::getText(*pc));
+            printf("\n");
+        }
+    }
+}
+
+template <typename MapT>
+int WordRectSearchMgr<MapT>::nextShape(int& wide, int& tall, const int& minTall, const int& maxTall
+    , const int& minArea, const int& maxArea, const int& maxWide) const
+{
+    if (mGridRows.empty())
+        return nextWantWideTall(wide, tall, minTall, maxTall, minArea, maxArea, maxWide, mAscending);
+    if (wide >= 0)
+        return 0;
+    wide = (int)mGridRows[0].size();
+    tall = (int)mGridRows.size();
+    return wide*tall;
+}
+
 template <typename MapT>
 int WordRectSearchMgr<MapT>::nextWantWideTall(int& wide, int& tall, const int& minTall, const int& maxTall
     , const int& minArea, const int& maxArea, const int& maxWide, bool ascending)
@@ -4,7 +4,16 @@
 #ifndef WordRectSearchMgr_hpp
 #define WordRectSearchMgr_hpp
 
+#include <map>
+#include <string>
+#include <vector>
+
 #include "WordRectFinder.hpp"
+#include "WordRectEstimator.hpp"
+#include "WordRectCounter.hpp"
+#include "WordRectPruner.hpp"
+#include "WordRectFrontier.hpp"
+#include "WordRectResults.hpp"
 #include "WordRectSearchExec.hpp"
 
 #ifndef _MBCS	// Microsoft Compiler
@@ -31,8 +40,8 @@ class WordRectSearchMgr
 public:
     typedef unsigned long (*finderThreadFnType)(void *pvArgs);
 
-    WordRectSearchMgr(WordTrie<MapT, TrixNode> **wordTries, WordMap *wordMaps, uint managerFlags, int verbosity)
-        : mWordTries(wordTries), mWordMaps(wordMaps), mManagerFlags(managerFlags)
+    WordRectSearchMgr(WordTrie<MapT, RectNode> **wordTries, WordArray *wordArrays, uint managerFlags, int verbosity)
+        : mWordTries(wordTries), mWordArrays(wordArrays), mManagerFlags(managerFlags)
     {
         mAscending		= (managerFlags & WordRectSearchExec::eIncreasingSize)   > 0 ? true : false;
         mFindLattices	= (managerFlags & WordRectSearchExec::eFindLattices)	 > 0 ? true : false;
@@ -41,8 +50,22 @@ public:
         mSingleThreaded = (managerFlags & WordRectSearchExec::eSingleThreaded)	 > 0 ? true : false;
         mUseTracNodes   = (managerFlags & WordRectSearchExec::eTransformIndexes) > 0 ? true : false;
         sAbortIfTrumped = (managerFlags & WordRectSearchExec::eAbortIfTrumped)   > 0 ? true : false;
+        mCountOnly      = (managerFlags & WordRectSearchExec::eCountOnly)        > 0 ? true : false;
+        mPruneShapes    = (managerFlags & WordRectSearchExec::ePruneShapes)      > 0 ? true : false;
+        sFinderOptions  = managerFlags & WordRectSearchExec::eUseArrays;   // the rect finders' own options
+        if (mCountOnly)
+            sAbortIfTrumped = false;    // a census must not skip smaller shapes
 
         sVerbosity      = verbosity;    // expecting default value of 1
+        sTimeBudget     = 0;
+        mNumShufflers   = 0;
+        mMaxWordLength  = 0;
+        mFrontierDepth  = 0;
+        mResultsFile    = NULL;
+        mRevTries       = NULL;
+        mOrientation    = eTopRowFirst;
+        mFindGrids      = false;
+        mGridPattern    = NULL;
     }
 
     WordRectSearchMgr(const WordRectSearchMgr&);                // don't define
@@ -59,6 +82,48 @@ public:
 
     inline static int		getTrumpingArea()       { return sTrumpingArea; }    
 
+    /** Anytime mode: give up on the whole search after this many seconds (0 means no limit). */
+    inline void             setTimeBudget(int seconds) { sTimeBudget = seconds; }
+    inline static int       getTimeBudget()         { return sTimeBudget; }
+
+    /** Randomized restarts: search each shape with this many differently seeded shuffle finders (0 for none). */
+    inline void             setNumShuffleFinders(int num) { mNumShufflers = num; }
+
+    /** Start the plain rect finders of each width from shared blocks of this many rows (0 for none). */
+    inline void             setFrontierDepth(int depth) { mFrontierDepth = depth; }
+
+    /** Skip the shapes decided by earlier runs, as found in this file, and add the ones decided now (NULL for none). */
+    inline void             setResultsFile(const char *fileName) { mResultsFile = fileName; }
+
+    /**
+    * Fill plain rect finders' shapes from the side given, or from the best side for each shape,
+    * using these tries of the words spelled backwards for the bottom or right side (NULL for none).
+    */
+    inline void             setReverseTries(WordTrie<MapT, RectNode> **revTries, RectOrientation orient)
+    {
+        mRevTries    = revTries;
+        mOrientation = revTries != NULL ? orient : eTopRowFirst;
+    }
+
+    /**
+    * Fill grids instead of rects (see WordGrid): the one masked in the file named spec, or for
+    * each shape in range, the rect, lattice, or waffle pattern named spec.  Returns the number
+    * of slots in the file's grid (0 for a pattern), or -1 if it cannot be filled.
+    */
+    int                     setGridMask(const char *spec, uint maxWordLength);
+
+    /** What became of one shape searched in anytime mode: complete rects found, or the deepest partial rect. */
+    struct ShapeReport
+    {
+        int                 mWide;
+        int                 mTall;
+        int                 mMaxTall;           // == mTall if any complete rect was found
+        int                 mNumFound;
+        typename WordRectFinder<MapT>::FinderState mState;
+        std::vector<std::string>  mRows;        // mMaxTall rows, copied, since grid finders' rows are their own
+    };
+    inline static const std::vector<ShapeReport>& getShapeReports() { return sShapeReports; }
+
     class FinderThreadInfo 
     {      // private struct type for tracking finder threads
     public:
@@ -78,6 +143,31 @@ public:
 
     int  manageSearch(uint minArea, uint minTall, uint maxTall, uint maxArea, uint maxWide, uint numEach, uint numTot);
 
+    /** Estimate, without searching, the search tree size and runtime for one shape, or for each shape in range. */
+    void estimateShape(int wide, int tall, uint numProbes, typename WordRectEstimator<MapT>::Estimate& est) const;
+    int  estimateSearch(uint minArea, uint minTall, uint maxTall, uint maxArea, uint maxWide, uint numProbes);
+
+    /** Count all rects of each shape no taller than WordRectCounter::sMaxTall by dynamic programming, and show some at random. */
+    int  countSearch(uint minArea, uint minTall, uint maxTall, uint maxArea, uint maxWide, uint numSamples);
+
+    /** Grid finder for one shape of the grid pattern, or for the grid mask, or NULL if it cannot be filled. */
+    WordRectFinder<MapT> * newGridFinder(int wide, int tall, uint numToFind) const;
+
+    /** Plain finder for one shape: specialized for its width if possible, else the generic one. */
+    WordRectFinder<MapT> * newRectFinder(WordTrie<MapT, RectNode> *wordTries[], int wide, int tall, uint numToFind) const;
+
+    /** Tries of only the words that can fit one rect shape (with -p), reported at verbosity 2 or more. */
+    WordRectPruner<MapT> * newPruner(WordTrie<MapT, RectNode> *wordTries[], int wide, int tall) const;
+
+    /** The side to fill a rect shape from: the one set, or else the one with the smallest estimated search tree. */
+    RectOrientation         chooseOrientation(int wide, int tall) const;
+
+    /** Blocks of shallow rows shared by all the heights in range for one width (with -f), or NULL if only one height would use them. */
+    WordRectFrontier<MapT> * newFrontier(int wide, int minTall, int maxTall, int minArea, int maxArea) const;
+
+    /** Hash of all the words in the tries, in order, to tell one dictionary's results from another's. */
+    uint64                  fingerprintWords() const;
+
     static void printWordRectMutex(WordRectFinder<MapT> *pWRF);
     static void printWordWaffleMutex(WordRectFinder<MapT> *pWRF);
 
@@ -87,16 +177,27 @@ private:
     // static finderThreadFnType finderThreadFunc;
 
     static void sigintHandler ( int sig );
+    static void recordShapeReport(const WordRectFinder<MapT> *pWRF);
+    static void printShapeReports(time_t timeNow);
+    static void recordResult(const WordRectFinder<MapT> *pWRF);
+    bool        useKnownResult(int wide, int tall);
 
     static int nextWantWideTall(int& wide, int& tall, const int& minTall, const int& maxTall
         , const int& minArea, const int& maxArea, const int& maxWide, bool ascending);
 
+    /** Like nextWantWideTall, but a grid mask from a file has just the one shape, in any range. */
+    int         nextShape(int& wide, int& tall, const int& minTall, const int& maxTall
+        , const int& minArea, const int& maxArea, const int& maxWide) const;
+
+    /** Whether the shapes are plain rects, not lattices, waffles, or grids. */
+    inline bool findsRects() const { return !mFindLattices && !mFindWaffles && !mFindGrids; }
+
 
 
 private:    // data
 
-    WordTrie<MapT, TrixNode> ** mWordTries;	// pointer to array of pointers to trie, indexed by word length.  Tries owned by the Exec!
-    WordMap                   * mWordMaps;	// pointer to array of word maps, indexed by word length
+    WordTrie<MapT, RectNode> ** mWordTries;	// pointer to array of pointers to trie, indexed by word length.  Tries owned by the Exec!
+    WordArray                 * mWordArrays;	// pointer to array of word arrays, indexed by word length
     uint                        mNumEach;
     uint                        mNumTotal;
 
@@ -104,11 +205,22 @@ private:    // data
     uint                mManagerFlags;
     bool                mFindLattices;
     bool                mFindWaffles;
+    bool                mFindGrids;     // fill mGridRows, or each shape of the mGridPattern
     bool                mOnlyOddDims;
     bool                mAscending;   // search in order (roughly) of ascending area (default value 0, for biggest first)
-    bool                mUseMaps;     
     bool                mSingleThreaded; 
     bool                mUseTracNodes;
+    bool                mCountOnly;
+    bool                mPruneShapes;   // search, count, or estimate each rect shape with its own pruned tries
+    uint                mMaxWordLength; // length of the longest words, and of mWordTries less one
+    int                 mNumShufflers;  // number of WordRectShuffleFinders per shape, or 0 to use the default finders
+    int                 mFrontierDepth; // rows in the blocks shared by the finders of each width, or 0 for no sharing
+    const char        * mResultsFile;   // file of results from earlier runs, or NULL
+    WordTrie<MapT, RectNode> ** mRevTries;  // tries of the words spelled backwards, indexed by word length, or NULL
+    RectOrientation     mOrientation;   // side to fill plain rect finders' shapes from, or eBestSideFirst
+    const char        * mGridPattern;   // name of the grid pattern to fill in each shape, or NULL for mGridRows
+    std::vector<std::string> mGridRows; // grid mask read from a file
+    std::string         mGridKind;      // kind of grid, for the results file
 
     // static data
     static FinderThreadInfo   * sFinders[sHardMaxFinders];  // array for tracking workers	
@@ -121,6 +233,14 @@ private:    // data
     static int			sTrumpingArea;
     static int			sMinimumArea;
     static bool         sAbortIfTrumped;
+    static int          sTimeBudget;          // Seconds for the whole search in anytime mode, or 0
+    static time_t       sDeadline;            // sSearchStartTime + sTimeBudget
+    static int          sShapesLeft;          // Number of shapes not yet begun (anytime mode)
+    static std::vector<ShapeReport> sShapeReports;
+    static uint64       sTotalCounted;        // Counting mode: rects counted by all finders
+    static uint64       sTotalSymCounted;     // Counting mode: symmetric squares counted by all finders
+    static WordRectResults *sResults;         // Results of earlier runs on this dictionary, if any
+    static const char * sResultKind;          // Kind of finder the results are for: rect, lattice, waffle, or grid-...
 };
 
 #endif // WordRectSearchMgr_hpp
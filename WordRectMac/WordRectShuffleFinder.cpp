@@ -0,0 +1,119 @@
+// WordRectShuffleFinder.cpp : find word rectangles with randomized branch order and restarts
+
+#include "WordRectShuffleFinder.hpp"
+#include "WordRectSearchMgr.hpp"
+
+template <typename MapT>
+void WordRectShuffleFinder<MapT>::initRowsAndCols()
+{
+    WordRectFinder<MapT>::initRowsAndCols();
+    if (mOrder == NULL)
+        mOrder = new uint[this->mWantTall * this->mWantWide * mNumIdx];
+}
+
+/** Give every cell a fresh random permutation of the char indices (Fisher-Yates). */
+template <typename MapT>
+void WordRectShuffleFinder<MapT>::shuffleOrders()
+{
+    uint *order = mOrder;
+    for (int cell = this->mWantTall * this->mWantWide; --cell >= 0; order += mNumIdx) {
+        for (uint j = 0; j < mNumIdx; j++)
+            order[j] = mBegIdx + j;
+        for (uint j = mNumIdx; j > 1; j--) {
+            uint k = mRandom.below(j);
+            uint t = order[j-1];
+            order[j-1] = order[k];
+            order[k] = t;
+        }
+    }
+}
+
+template <typename MapT>
+uint WordRectShuffleFinder<MapT>::luby(uint run)
+{
+    uint size = 1, seq = 0;
+    while (size < run + 1) {
+        ++seq;
+        size = 2*size + 1;
+    }
+    while (size - 1 != run) {
+        size = (size - 1) >> 1;
+        --seq;
+        run = run % size;
+    }
+    return 1u << seq;
+}
+
+template <typename MapT>
+int WordRectShuffleFinder<MapT>::findWordRows()
+{
+    for (uint run = 0; ; ++run) {
+        shuffleOrders();
+        mRestart   = false;
+        mNodeLimit = this->mNumNodes + (uint64)sRestartUnit * luby(run);
+        int area = findRowLetters(0, 0);
+        if (area < 0 || (area > 0 && this->getNumFound() == this->getNumToFind())) {
+            return area;                    // aborted, timed out, or found enough
+        }
+        if ( ! mRestart ) {
+            return this->getNumFound() > 0 ? this->mWantArea : 0;  // this run was exhaustive
+        }
+        ++mNumRestarts;
+        if (WordRectSearchMgr<MapT>::getVerbosity() > 2) {
+            printf("Restart %2d * %2d: run %d gave up at %d rows after %d seconds\n"
+                , this->mWantWide, this->mWantTall, run, this->mMaxTall, (int)(time(NULL) - this->mStartTime));
+        }
+    }
+}
+
+/**
+* Add the letter in column col of row haveTall, trying the letters in this cell's
+* shuffled order.  Each letter must extend both the row stem and the column stem.
+*/
+template <typename MapT>
+int WordRectShuffleFinder<MapT>::findRowLetters(int haveTall, int col)
+{
+    if (col == 0) {
+        this->mNowTall = haveTall;
+        if (haveTall > 1 && this->mWantArea <= WordRectSearchMgr<MapT>::getTrumpingArea()) {
+            this->mState = WordRectFinder<MapT>::eAborted;
+            return -this->mWantArea;  // Abort because a wordRect bigger than wantArea has been found
+        }
+        if (this->isPastDeadline()) {
+            this->mState = WordRectFinder<MapT>::eTimedOut;
+            return -this->mWantArea;  // Abort because this finder's time is up
+        }
+        if (haveTall == this->mWantTall) {
+            return this->recordFoundRect(haveTall);
+        }
+        if (this->mMaxTall < haveTall)
+            this->recordDeeperRows(haveTall);
+        if (this->mNumNodes >= mNodeLimit && this->getNumFound() == 0) {
+            mRestart = true;          // This run has had its chance
+            return 0;
+        }
+    } else if (col == this->mWantWide) {
+        this->mRowWordsNow[haveTall] = this->mRowNodes[haveTall][this->mWantWideM1]->getStem();
+        return findRowLetters(haveTall + 1, 0);
+    }
+
+    const RectNode *rowNode = this->mRowNodes[haveTall][col-1];
+    const RectNode *colNode = this->mColFront[haveTall-1][col];
+    const uint *order = &mOrder[(haveTall * this->mWantWide + col) * mNumIdx];
+    for (uint j = 0; j < mNumIdx; j++) {
+        uint index = order[j];
+        const RectNode *rowBranch = rowNode->getBranchAtIndex(index);
+        if (rowBranch == NULL)
+            continue;
+        const RectNode *colBranch = colNode->getBranchAtIndex(index);
+        if (colBranch == NULL)
+            continue;
+        this->mRowNodes[haveTall][col] = rowBranch;
+        this->mColFront[haveTall][col] = colBranch;
+        int area = findRowLetters(haveTall, col + 1);
+        if (area < 0 || (area > 0 && this->getNumFound() == this->getNumToFind()) || mRestart) {
+            return area;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,60 @@
+// WordRectShuffleFinder.hpp : find word rectangles with randomized branch order and restarts
+
+#ifndef WordRectShuffleFinder_hpp
+#define WordRectShuffleFinder_hpp
+
+#include "WordRectFinder.hpp"
+#include "wordRandom.h"
+
+/**
+*   Randomized variant of the word rect finder.  Instead of taking row words in
+*   trie (alphabetic) order, it builds each row letter by letter, trying the letters
+*   for each cell in a pseudo-random order drawn from its own seed.  A run that has
+*   visited too many nodes without finding a rect is abandoned, and the next run
+*   starts over with new letter orders.  The node limits follow the Luby schedule
+*   (1 1 2 1 1 2 4 1 1 2 ...) times sRestartUnit, which is within a log factor of the
+*   best fixed cutoff without knowing it in advance.  Several of these finders with
+*   different seeds can search the same shape at once, so that the first solution
+*   need not wait for one lucky order.  Once a rect has been found, the current run
+*   is not restarted again, so it finishes exhaustively and no rect is counted twice.
+*/
+template <typename MapT>
+class WordRectShuffleFinder : public WordRectFinder<MapT>
+{
+public:
+    static const uint sRestartUnit = 1 << 14;   // nodes (rows tried) per unit of the Luby schedule
+
+    WordRectShuffleFinder(WordTrie<MapT, RectNode> *wordTries[], const WordArray *arrays, int wide, int tall, uint numToFind, uint options, uint64 seed)
+        : WordRectFinder<MapT>(wordTries, arrays, wide, tall, numToFind, options)
+        , mRandom(seed), mOrder(NULL)
+        , mBegIdx(wordTries[wide]->charMap().targetBegIdx())
+        , mNumIdx(wordTries[wide]->charMap().targetSize())
+        , mNodeLimit(0), mRestart(false), mNumRestarts(0)
+    { }
+
+    WordRectShuffleFinder(const WordRectShuffleFinder&);              // Prevent pass-by-value by not defining this copy constructor.
+    WordRectShuffleFinder& operator=(const WordRectShuffleFinder&);   // Prevent assignment by not defining this operator.
+    virtual ~WordRectShuffleFinder() { delete [] mOrder; }
+
+    inline uint         getNumRestarts()    const   { return mNumRestarts; }
+
+    static uint         luby(uint run);     // 0-based: luby(0) == 1, luby(2) == 2, luby(6) == 4
+
+protected:
+    virtual void initRowsAndCols();
+
+private:
+    virtual int  findWordRows();
+    int          findRowLetters(int haveTall, int col);
+    void         shuffleOrders();
+
+    WordRandom          mRandom;
+    uint              * mOrder;             // For each cell, a permutation of the char indices
+    const uint          mBegIdx;
+    const uint          mNumIdx;
+    uint64              mNodeLimit;         // Restart when mNumNodes reaches this
+    bool                mRestart;           // Is the current run unwinding for a restart?
+    uint                mNumRestarts;
+};
+
+#endif // WordRectShuffleFinder_hpp
@@ -0,0 +1,117 @@
+// WordScanner.cpp : finds the words in a block of text, 16 or 32 bytes at a time
+
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define WORD_SCANNER_SSE2 1
+#endif
+
+#include "WordScanner.hpp"
+
+WordScanner::WordScanner(const bool isWordChar[sNumChars]) : mPos(NULL), mEnd(NULL)
+{
+    memcpy(mIsWordChar, isWordChar, sizeof(mIsWordChar));
+    for (uint uc = 0; uc <= sSpace; uc++)
+        mIsWordChar[uc] = false;        // spaces end words, whatever the map says
+    mIsWordChar[sEndChar] = false;
+}
+
+/** Index of the lowest set bit of a non-zero mask. */
+static inline uint lowestBit(uint mask)
+{
+#if defined(__GNUC__)
+    return (uint)__builtin_ctz(mask);
+#else
+    uint idx = 0;
+    while ((mask & 1) == 0) {
+        mask >>= 1;
+        idx++;
+    }
+    return idx;
+#endif
+}
+
+// The vector loops compare unsigned bytes for <= Space as max(byte, Space) == Space,
+// since SSE2 and AVX2 only compare signed bytes for order.
+
+const char * WordScanner::findSpace(const char *pc, const char *end)
+{
+#if defined(__AVX2__)
+    const __m256i space32 = _mm256_set1_epi8((char)sSpace);
+    for ( ; end - pc >= 32; pc += 32) {
+        __m256i bytes = _mm256_loadu_si256((const __m256i *)pc);
+        uint mask = (uint)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(bytes, space32), space32));
+        if (mask != 0)
+            return pc + lowestBit(mask);
+    }
+#elif WORD_SCANNER_SSE2
+    const __m128i space16 = _mm_set1_epi8((char)sSpace);
+    for ( ; end - pc >= 16; pc += 16) {
+        __m128i bytes = _mm_loadu_si128((const __m128i *)pc);
+        uint mask = (uint)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(bytes, space16), space16));
+        if (mask != 0)
+            return pc + lowestBit(mask);
+    }
+#endif
+    for ( ; pc < end; pc++) {
+        if ((uchr)*pc <= sSpace)
+            break;
+    }
+    return pc;
+}
+
+const char * WordScanner::skipSpaces(const char *pc, const char *end)
+{
+#if defined(__AVX2__)
+    const __m256i space32 = _mm256_set1_epi8((char)sSpace);
+    for ( ; end - pc >= 32; pc += 32) {
+        __m256i bytes = _mm256_loadu_si256((const __m256i *)pc);
+        uint mask = ~(uint)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(bytes, space32), space32));
+        if (mask != 0)
+            return pc + lowestBit(mask);
+    }
+#elif WORD_SCANNER_SSE2
+    const __m128i space16 = _mm_set1_epi8((char)sSpace);
+    for ( ; end - pc >= 16; pc += 16) {
+        __m128i bytes = _mm_loadu_si128((const __m128i *)pc);
+        uint mask = 0xFFFF & ~(uint)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(bytes, space16), space16));
+        if (mask != 0)
+            return pc + lowestBit(mask);
+    }
+#endif
+    for ( ; pc < end; pc++) {
+        if ((uchr)*pc > sSpace)
+            break;
+    }
+    return pc;
+}
+
+bool WordScanner::nextWord(const char *&word, uint &length)
+{
+    while (mPos < mEnd) {
+        const char *run = skipSpaces(mPos, mEnd);
+        if (run == mEnd)
+            break;
+        const char *runEnd = findSpace(run, mEnd);
+        mPos = runEnd;                  // the caller may overwrite *runEnd, but it is still a space
+
+        const char *pc = run;
+        while (pc < runEnd && isPunct((uchr)*pc) && ! mIsWordChar[(uchr)*pc])
+            pc++;                       // skip leading punct
+        const char *beg = pc;
+        while (pc < runEnd && mIsWordChar[(uchr)*pc])
+            pc++;
+        if (pc == beg)
+            continue;                   // no word chars, or an unmapped char first
+        if (pc < runEnd && ! isPunct((uchr)*pc))
+            continue;                   // an unmapped char inside the word rejects it
+        word   = beg;
+        length = (uint)(pc - beg);      // pointer arithmetic
+        return true;
+    }
+    mPos = mEnd;
+    return false;
+}
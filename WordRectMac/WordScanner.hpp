@@ -0,0 +1,75 @@
+// WordScanner.hpp : finds the words in a block of text, 16 or 32 bytes at a time
+
+#ifndef WordScanner_hpp
+#define WordScanner_hpp
+
+#include <stddef.h>
+
+#include "wordTypes.h"
+
+/**
+*   Splits text into words by the rules addLineWordsToTrie always used, but looks for the
+*   word boundaries with SIMD compares (AVX2 or SSE2, whichever the build targets, else
+*   one byte at a time) instead of running a state machine over every byte.
+*
+*   Each byte is one of four kinds:
+*       space       <= Space, including line ends, control chars, and NULL
+*       word        mapped by the CharMap the scanner was made with
+*       punct       not mapped, and between '9' and 'A' (: ; < = > ? @)
+*       unmapped    anything else
+*   The text between spaces is a run.  Punct at the start of a run is skipped; then the
+*   word chars that follow make a word if the run ends there or at punct (after which
+*   the rest of the run is ignored).  A run with an unmapped char before any punct, or
+*   in place of its first word char, has no word.
+*
+*   Since only the space bytes are found with vector compares, scanning costs about the
+*   same as reading the text when the runs are words, which they mostly are.
+*/
+class WordScanner
+{
+public:
+    static const uint sNumChars = 256;
+
+    /** Set up to scan words of the chars for which isWordChar is true (true for isWordChar[uc] only if uc > Space). */
+    WordScanner(const bool isWordChar[sNumChars]);
+
+    /** Make isWordChar from any char map, with the same test addLineWordsToTrie used.  Chars outside the map's source range are not looked up. */
+    template <typename MapT>
+    static void makeWordChars(const MapT& charMap, bool isWordChar[sNumChars])
+    {
+        uint endMapIdx = charMap.targetEndIdx();
+        for (uint uc = 0; uc < sNumChars; uc++) {
+            isWordChar[uc] = uc > sSpace && uc < sEndChar && charMap.sourceMinChar() <= uc && uc <= charMap.sourceMaxChar()
+                && charMap.charToIndex((uchr)uc) < endMapIdx;
+        }
+    }
+
+    /** Start on text[0, size), which must not change, except as allowed by nextWord, until scanning is done. */
+    void        reset(const char *text, size_t size) { mPos = text; mEnd = text + size; }
+
+    /**
+    * Find the next word, setting word to its start and length to its length.  Returns false
+    * at the end of the text.  The scan has already moved past the char after the word, so
+    * the caller may write a NULL there before calling nextWord again (for the last word,
+    * that char is text[size], so the caller must own it).
+    */
+    bool        nextWord(const char *&word, uint &length);
+
+    /** The first byte in [pc, end) that is a space (<= Space), or end. */
+    static const char * findSpace(const char *pc, const char *end);
+
+    /** The first byte in [pc, end) that is not a space, or end. */
+    static const char * skipSpaces(const char *pc, const char *end);
+
+private:
+    static const uint   sSpace   = ' ';     // same as CharFreqMap::sBegChar
+    static const uint   sEndChar = 255;     // same as CharFreqMap::sEndChar: never a word char
+
+    static inline bool  isPunct(uchr uc) { return '9' < uc && uc < 'A'; }
+
+    bool                mIsWordChar[sNumChars];
+    const char        * mPos;
+    const char        * mEnd;
+};
+
+#endif // WordScanner_hpp
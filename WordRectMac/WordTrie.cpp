@@ -2,6 +2,9 @@
 // Sprax Lines, July 2010
 
 #include "WordTrie.hpp"
+#include "TextWordCounts.hpp"
+#include "WordScanner.hpp"
+#include <string.h>
 #include <unistd.h>
 
 /**
@@ -12,113 +15,40 @@
  * characters, such as whitespace or punctuation.
  */
 
-//private:
-/** Is an unsigned char that is greater than Space a punctuation character
- *  for purposes of word boundary detection? */
-static inline bool isUchrGtSpacePunct(uchr uc) { return ('9' < uc && uc < 'A'); }
-
-//  WordTrie Parse States
-
-typedef enum { 
-    eInsideWord         = 0,
-    eWhitespace         = 1,
-    eUnmappedChar       = 2,
-    // eUnmappedPunct   = 3
-} ParseState;
-
+/**
+ * Add the words in text[0, size) to the trie, NULL-terminating each one that is added
+ * in place, so text[size] must be writable.
+ */
 template <typename MapT, typename NodeT>
-int WordTrie<MapT, NodeT>::addLineWordsToTrie(WordTrie<MapT, NodeT> *trie, char *line, const uint minWordLength, const uint maxWordLength)
+int WordTrie<MapT, NodeT>::addTextWordsToTrie(WordTrie<MapT, NodeT> *trie, WordScanner& scanner, char *text, size_t size
+    , const uint minWordLength, const uint maxWordLength)
 {
     int numWordsAdded = 0;
-    assert(line);
-    const CharMap& charMap = trie->charMap();
-    ParseState chrState = eWhitespace;        
-    char *pBegWord;
-    uint  endMapIdx = charMap.targetEndIdx();
-    for (register char *ptrSigned = line; ; ++ptrSigned) {
-        
-        register uchr valUnsigned = *ptrSigned; // value as unsigned char
-        
-        switch(chrState) {
-                
-            case eInsideWord:
-                // Inside a sub-string that may be a word
-                // Find whitespace, punctuation, or the end of the line to end this word.
-                // or find an unmapped char to invalidate this word.
-                // Otherwise, stay in this state.
-                
-                if (valUnsigned <= CharFreqMap::sBegChar) {
-                    // Up to here, this sub-string's chars are all mapped, so if it is long 
-                    // enough, NULL-terminate it and add it to the trie as a valid word.  
-                    uint wordLength = (uint)(ptrSigned - pBegWord);
-                    if (minWordLength <= wordLength && wordLength <= maxWordLength) {
-                        *ptrSigned = '\0';
-                        if (trie->insertWord(pBegWord, NULL)) {
-                            numWordsAdded++;
-                        }
-                    }
-                    if (valUnsigned == 0) {
-                        return numWordsAdded;   // Word end was also the line end, so don't set state, just return.
-                    } else {
-                        chrState = eWhitespace;         // Word end was whitespace, so set state to whitespace and continue
-                    }
-                } else {
-                    // Terminate on punctuation; otherwise, reject any string with unmapped char
-                    uint idx = charMap.charToIndex(valUnsigned);
-                    if (idx >= endMapIdx) {
-                        chrState = eUnmappedChar;
-                        // If non-whitespace, unmapped char is punctuation, then end the word instead of invalidating it,
-                        // but leave the state as invalid, so that actual white space must be found before the next word.
-                        // But if any punctuation chars are mapped, they can appear inside words, e.g. "hyphen-mark".
-                        if (isUchrGtSpacePunct(valUnsigned)) {
-                            uint wordLength = uint(ptrSigned - pBegWord);
-                            if (minWordLength <= wordLength && wordLength <= maxWordLength) {
-                                *ptrSigned = '\0';
-                                if (trie->insertWord(pBegWord, NULL)) {
-                                    numWordsAdded++;
-                                }
-                            }
-                        }
-                    }
-                }
-                break;
-                
-            case eWhitespace:   // If current state is whiteSpace, find a letter to change the state.
-                
-                if (valUnsigned > CharFreqMap::sBegChar) {
-                    uint idx = charMap.charToIndex(valUnsigned);
-                    if (idx >= endMapIdx) {
-                        if (isUchrGtSpacePunct(valUnsigned)) {
-                            // If this unmapped char is punctuation after whitespace; ignore it
-                            break;                           // Let the state remain whitespace.
-                        } else {
-                            // reject strings with any other unmapped char
-                            chrState = eUnmappedChar;   // Set the state to invalid word.
-                        }
-                    } else {
-                        pBegWord = ptrSigned;
-                        chrState = eInsideWord;
-                    }
-                } else if (valUnsigned == 0) {      // End of line, not in a word, so return
-                    return numWordsAdded;
-                }
-                break;
-                
-            case eUnmappedChar:    // Find whitespace or end of line to get out of this state 
-                if (valUnsigned <= CharFreqMap::sBegChar) {
-                    if (valUnsigned == 0) {         // End of line, not in a word, so just return
-                        break;
-                    } else {
-                        chrState = eWhitespace;             // whitespace
-                    }
-                }
-                break;
-                
+    const char *word;
+    uint wordLength;
+    scanner.reset(text, size);
+    while (scanner.nextWord(word, wordLength)) {
+        if (minWordLength <= wordLength && wordLength <= maxWordLength) {
+            char *pBegWord = text + (word - text);      // the same char, but writable
+            pBegWord[wordLength] = '\0';
+            if (trie->insertWord(pBegWord, NULL)) {
+                numWordsAdded++;
+            }
         }
     }
     return numWordsAdded;
 }
 
+template <typename MapT, typename NodeT>
+int WordTrie<MapT, NodeT>::addLineWordsToTrie(WordTrie<MapT, NodeT> *trie, char *line, const uint minWordLength, const uint maxWordLength)
+{
+    assert(line);
+    bool isWordChar[WordScanner::sNumChars];
+    WordScanner::makeWordChars(trie->charMap(), isWordChar);
+    WordScanner scanner(isWordChar);
+    return addTextWordsToTrie(trie, scanner, line, strlen(line), minWordLength, maxWordLength);
+}
+
 /** 
  * Supplement WordTrie with words from a text file.
  * 
@@ -131,31 +61,39 @@ int WordTrie<MapT, NodeT>::addLineWordsToTrie(WordTrie<MapT, NodeT> *trie, char
 
 
 template <typename MapT, typename NodeT>
-int WordTrie<MapT, NodeT>::addAllWordsInTextFile(const char *fileSpec, WordTrie<MapT, NodeT> *trie, uint minWordLength, uint maxWordLength, int verbosity)
+int WordTrie<MapT, NodeT>::addAllWordsInTextFile(const char *fileSpec, WordTrie<MapT, NodeT> *trie, uint minWordLength, uint maxWordLength, int verbosity
+    , uint numThreads)
 {   
-    uint numLineWordsAdded, numWordsAdded = 0;
+    int numWordsAdded = 0;
     
     printf("============ Working Directory: %s\n", getcwd(NULL, 0));
-    
-    FILE *fi;
-    if ( ! fopen_safe(&fi, fileSpec, "r") ) {
-        printf("%s opened by %s\n" , fileSpec, __FUNCTION__);
-    } else {
+
+    // Count the words first, in as many threads as asked, each with its own counts,
+    // and then add each distinct word to the trie just once, with its total count.
+    bool isWordChar[WordScanner::sNumChars];
+    WordScanner::makeWordChars(trie->charMap(), isWordChar);
+    std::vector<TextWordCounts> counts(numThreads > 0 ? numThreads : 1);
+    long numBytesRead = TextWordCounts::countWordsInFile(fileSpec, isWordChar, minWordLength, maxWordLength, counts);
+    if (numBytesRead < 0) {
         printf("Error opening dictionary file: %s\n", fileSpec);
         return 0;
     }
-    
-    uint  numLinesRead = 0;
-    char  line[CharFreqMap::sBufSize];
-    while (fgets(line, CharFreqMap::sBufSize, fi))  {        
-        numLinesRead++;
-        numLineWordsAdded = addLineWordsToTrie(trie, line, minWordLength, maxWordLength);
-        numWordsAdded += numLineWordsAdded;
+    printf("%s read by %s\n" , fileSpec, __FUNCTION__);
+
+    uint numDistinct = 0;
+    for (uint t = 0; t < counts.size(); t++) {
+        const TextWordCounts& tc = counts[t];
+        numDistinct += tc.getNumWords();
+        for (uint j = 0; j < tc.getNumWords(); j++) {
+            if (trie->insertWordCount(tc.getWord(j), tc.getCount(j))) {
+                numWordsAdded++;
+            }
+        }
     }
     
     if (verbosity > 1)
-        printf("Read %d lines, added %d new words from %s\n", numLinesRead, numWordsAdded, fileSpec);
-    fclose(fi);
+        printf("Read %ld bytes in %u threads, added %d new words (of %u per-thread distinct) from %s\n"
+            , numBytesRead, (uint)counts.size(), numWordsAdded, numDistinct, fileSpec);
     return numWordsAdded;  // return the number of words read, not necessarily kept.
 }
 
@@ -4,24 +4,99 @@
 #ifndef WordTrie_hpp
 #define WordTrie_hpp
 
+#include <algorithm>
+#include <stdlib.h>
+#include <string.h>
 #include <vector>
 
 #include "CharFreqMap.hpp"
 #include "TrixNode.hpp"
+#include "TryNode.hpp"
+#include "WordPool.hpp"
 #include "wordPlatform.h"
 
+#define USE_TRY_NODES 0     // If 1, the word rect finders' tries are made of TryNodes, each with a branch array only as big as
+                            // the number of chars that occur at its depth, instead of TrixNodes, which have one for every char.
+#if USE_TRY_NODES
+typedef TryNode     RectNode;
+#else
+typedef TrixNode    RectNode;
+#endif
+
+class WordScanner;
+
 template <typename MapT, typename NodeT>
 class WordTrie 
 {
 public:
 
-    WordTrie(const MapT &charMap, uint wordLen) : mCharMap(charMap), mWordLength(wordLen), mTotalNodes(0)
+    /**
+    * If copyWords is false, the trie keeps pointers to the inserted words instead of
+    * duplicating them, so they must outlive it (as do the words of another trie).
+    */
+    WordTrie(const MapT &charMap, uint wordLen, bool copyWords=true)
+        : mCharMap(charMap), mWordLength(wordLen), mCopyWords(copyWords), mPool(NULL), mTotalNodes(0)
     {
         mRoot = new NodeT(mCharMap, 0);
     }
     WordTrie(WordTrie &);                               // Prevent pass-by-value by not defining copy constructor.
     WordTrie<MapT, NodeT>& operator=(const WordTrie&);  // Prevent assignment by not defining this operator.
-    ~WordTrie() { }                                     // Destroy all the nodes?	TODO: depth-first infanticide...
+    ~WordTrie() { deleteNodes(mRoot); delete mPool; }
+
+    /**
+    * Copy the next numWords new words into one WordPool instead of duplicating each one
+    * on its own (fixed-length tries that copy their words only).  Any words past that
+    * many are duplicated as before.  Call before inserting any words.
+    */
+    void reserveWords(uint numWords)
+    {
+        if (mCopyWords && mWordLength > 0 && mPool == NULL)
+            mPool = new WordPool(mWordLength, numWords);
+    }
+
+    /**
+    * Put words (all of this trie's length) in the order insertWord needs, which is sorted
+    * by this trie's char indices, not necessarily by char values.  Words already in order are
+    * left as they are; any others get an LSD radix sort: one stable counting pass per char
+    * position, last to first, so repeats end up next to each other.  Words with unmapped
+    * chars sort last at each position.  Returns true if it had to sort.
+    */
+    bool sortWords(std::vector<const char *>& words) const
+    {
+        assert(mWordLength > 0);
+        const uint numBuckets = mCharMap.targetEndIdx() + 1;     // the last one is for unmapped chars
+        uint bucketOf[256];
+        for (uint uc = 0; uc < 256; uc++) {
+            bool isMapped = mCharMap.sourceMinChar() <= uc && uc <= mCharMap.sourceMaxChar();     // else not in the map's table
+            uint ix = isMapped ? mCharMap.charToIndex((uchr)uc) : numBuckets - 1;
+            bucketOf[uc] = ix < numBuckets - 1 ? ix : numBuckets - 1;
+        }
+        size_t numWords = words.size(), j = 1;
+        for ( ; j < numWords; j++) {
+            const uchr *prev = (const uchr *)words[j-1], *next = (const uchr *)words[j];
+            uint k = 0;
+            while (k < mWordLength && bucketOf[prev[k]] == bucketOf[next[k]])
+                k++;
+            if (k < mWordLength && bucketOf[prev[k]] > bucketOf[next[k]])
+                break;
+        }
+        if (j >= numWords)
+            return false;
+
+        std::vector<uint> starts(numBuckets + 1);
+        std::vector<const char *> sorted(numWords);
+        for (int pos = mWordLength; --pos >= 0; ) {
+            std::fill(starts.begin(), starts.end(), 0);
+            for (size_t w = 0; w < numWords; w++)
+                starts[bucketOf[(uchr)words[w][pos]] + 1]++;
+            for (uint b = 1; b <= numBuckets; b++)
+                starts[b] += starts[b-1];
+            for (size_t w = 0; w < numWords; w++)
+                sorted[starts[bucketOf[(uchr)words[w][pos]]]++] = words[w];
+            words.swap(sorted);
+        }
+        return true;
+    }
 
     inline uint             charIndex(uchr uc)        const { return mCharMap.charToIndex(uc); }
     inline const MapT     & charMap()                 const { return mCharMap; }
@@ -43,8 +118,8 @@ public:
 #ifdef _DEBUG
         if (prevWordNode != NULL) {
             assert(prevWordNode->mStem);
-            uint prev0 = prevWordNode->getStem()[0];
-            uint word0 = word[0];
+            uint prev0 = charIndex(prevWordNode->getStem()[0]);     // in the map's order, not necessarily the chars'
+            uint word0 = charIndex(word[0]);
             assert(prev0 <= word0);
         }
 #endif
@@ -56,7 +131,11 @@ public:
             assert(mCharMap.sourceMinChar() <= uc && uc <= mCharMap.sourceMaxChar());
             uint ix = charIndex(uc);
             assert(ix < mCharMap.targetEndIdx());
-            if (node->mBranches[ix] == NULL) {
+            if (node->branchAt(ix) == NULL) {
+                if ( ! node->hasBranchSlot(ix)) {
+                    assert( ! "no branch slot for this char at this depth");
+                    return NULL;            // A TryNode's CharPosMap never saw this char here, so it cannot be added.
+                }
                 // create new branch node as a child the current one.  Some nodes types keep a pointer
                 // to their parent, and some may not even look at it, but we supply it in any case.
                 newNode = new NodeT(mCharMap, node->mDepth + 1, node);
@@ -68,8 +147,12 @@ public:
                 // its unique owner, but what about the other nodes whose mStem will point to it?
                 // Other candidates to be its owner are its actual word node, or the trie, or the *SearchExec,
                 // or the program as a whole (as it is now).                
-                if (newWord == NULL)
-                    newWord = strdup_safe(word);
+                if (newWord == NULL) {
+                    if ( ! mCopyWords)
+                        newWord = word;
+                    else if (mPool == NULL || (newWord = mPool->add(word)) == NULL)
+                        newWord = strdup_safe(word);
+                }
                 // Set mStem as a pointer to the first word off this stem.  
                 // If this node is a word-node, this stem is the node's word.
                 newNode->mStem =  newWord;
@@ -77,14 +160,14 @@ public:
                 if (node->mFirstBranch == NULL) {
                     node->mFirstBranch = newNode;    // This depends on alphabetical ordering!
                 } else for (int ib = ix; --ib >= 0; ) {
-                    if (node->mBranches[ib] != NULL) {
-                        node->mBranches[ib]->mNextBranch = newNode;
+                    if (node->branchAt(ib) != NULL) {
+                        node->branchAt(ib)->mNextBranch = newNode;
                         break;
                     }
                 }
-                node->mBranches[ix] = newNode;
+                node->branchAt(ix) = newNode;
             }
-            node = (NodeT *)node->mBranches[ix];
+            node = (NodeT *)node->branchAt(ix);
 
             if (*pc == '\0') {			  // End of the word.
                 assert(mWordLength == 0 || pc - word == mWordLength);
@@ -107,6 +190,27 @@ public:
         //  return NULL;				// unreachable code: either we return out of the loop or it or goes forever.
     }
 
+    /**
+    * Same as calling insertWord(word, NULL) count times, but the nodes' read-as callbacks
+    * are each called once with the count.  Returns the new word-node, or NULL if the
+    * word was already in the trie.
+    */
+    NodeT * insertWordCount(const char *word, uint count)
+    {
+        NodeT *newNode = insertWord(word, NULL);
+        if (count > 1) {
+            NodeT *node = mRoot;
+            for (const char *pc = word; *pc != '\0'; pc++) {
+                node = (NodeT *)node->branchAt(charIndex(*pc));
+                if (pc[1] == '\0')
+                    node->readAsDictWords(count - 1);
+                else
+                    node->readAsDictStems(count - 1);
+            }
+        }
+        return newNode;
+    }
+
 
     const NodeT * containsWord(const char *key) const
     {
@@ -115,7 +219,7 @@ public:
         while (*key != '\0') {
             uchr ucx = *key++;
             uint uix = mCharMap.charIndex(ucx);
-            node = node->mBranches[uix];
+            node = (const NodeT *)node->branchAt(uix);
             if (node == NULL) {
                 return  NULL;	// Not found - reached end of branch
             }
@@ -178,7 +282,7 @@ public:
         do {
             uchr uc = *key++;
             uint ux = charIndex(uc);
-            node = (NodeT *)node->mBranches[ux];
+            node = (NodeT *)node->branchAt(ux);
         } while (node != NULL && --idx >= 0);
         return node;
     }
@@ -193,7 +297,7 @@ public:
         for (const char *pc = nullTerminatedKey; *pc != '\0'; pc++) {
             uchr uc = *pc;
             uint ux = mCharMap.charIndex(uc);
-            node = node->mBranches[ux];
+            node = (const NodeT *)node->branchAt(ux);
             if (node == NULL) {
                 return  NULL;			// Not found - reached end of branch
             }
@@ -213,7 +317,7 @@ public:
         while (subKeyLength >= 0) {
             uchr uc = *subKey++;
             uint ux = charIndex(uc);
-            node = node->mBranches[ux];
+            node = (const NodeT *)node->branchAt(ux);
             if ( ! node ) {
                 return false;
             }
@@ -232,14 +336,19 @@ public:
      * Returns the number of "new" words, that is, words added to the WordTrie.
      */
     static int addLineWordsToTrie(WordTrie<MapT, NodeT> *trie, char *line, const uint minWordLength, const uint maxWordLength);
+
+    /** Same as addLineWordsToTrie, but for any span of text, found by a scanner made for this trie's char map. */
+    static int addTextWordsToTrie(WordTrie<MapT, NodeT> *trie, WordScanner& scanner, char *text, size_t size
+        , const uint minWordLength, const uint maxWordLength);
     
     /** 
-    * Supplement WordTrie with words from a text file.
+    * Supplement WordTrie with words from a text file, counted in numThreads threads.
     * 
     * Returns number of new words added.  Words already in the Trie, or outside the
     * specified length range, do not count.
     */
-    static int addAllWordsInTextFile(const char *fileSpec, WordTrie<MapT, NodeT> *trie, uint minWordLength, uint maxWordLength, int verbosity);
+    static int addAllWordsInTextFile(const char *fileSpec, WordTrie<MapT, NodeT> *trie, uint minWordLength, uint maxWordLength, int verbosity
+        , uint numThreads = 1);
 
 
     uint countBranchesPerChar(const CharFreqMap& freqMap)
@@ -304,8 +413,29 @@ public:
 
 
 private:
+    /**
+    * Depth-first infanticide: delete the children before the parent.  Each duplicated word
+    * is owned by the node where it ends, which is the one whose depth is the stem's length.
+    * Pooled words go with the pool.
+    */
+    void deleteNodes(NodeT *node)
+    {
+        bool ownsStem = mCopyWords && node->mDepth > 0 && (mPool == NULL || ! mPool->contains(node->mStem))
+            && strlen(node->mStem) == node->mDepth;     // before a child frees it
+        for (NodeT *child = (NodeT *)node->mFirstBranch; child != NULL; ) {
+            NodeT *next = (NodeT *)child->mNextBranch;
+            deleteNodes(child);
+            child = next;
+        }
+        if (ownsStem)
+            free((void *)node->mStem);
+        delete node;
+    }
+
     const MapT  & mCharMap;
     const uint    mWordLength;	// If this is > 0, all words must be exactly this long.
+    const bool    mCopyWords;   // Does the trie own duplicates of its words, or just point to them?
+    WordPool    * mPool;        // Where the copies go, if reserveWords was called
 
     NodeT       * mRoot;        // The root node has no parent, and its depth == 0.
 
@@ -14,16 +14,17 @@ void WordWaffleFinder<MapT>::initRowsAndCols()
 
     this->mRowWordsNow = (const char **)      new char*[this->mWantTall];
     this->mRowWordsOld = (const char **)      new char*[this->mWantTall];
-    this->mRowNodes    = (const TrixNode ***) new TrixNode**[this->mWantTall];
-    this->mColNodes    = (const TrixNode ***) new TrixNode**[this->mWantWide];
+    this->mRowWordsDeep = (const char **)     new char*[this->mWantTall];
+    this->mRowNodes    = (const RectNode ***) new RectNode**[this->mWantTall];
+    this->mColFrontRows = (const RectNode ***) new RectNode**[this->mWantTall + 2];
 
     // For each row, make rowNodes[row] point to the start of the word row,
     // which is one pointer address *after* the row's raw memory start, 
     // and make rowNodes[row][-1] point to the mRowTrie root.  This memory
     // offset allows word-node indexing to agree with word-character indexing.
     int wideP1 = this->mWantWide + 1;
-    int tallP1 = this->mWantTall + 1;
-    this->mRowNodesMem = (const TrixNode  **) new TrixNode*[wideP1 * this->mWantTall];
+    int tallP2 = this->mWantTall + 2;
+    this->mRowNodesMem = (const RectNode  **) new RectNode*[wideP1 * this->mWantTall];
     // Init the even row node arrays.  
     for (int row = 0; row < this->mWantTall; row += 2) {
         this->mRowNodes[row]     = &this->mRowNodesMem[row * wideP1 + 1];
@@ -35,19 +36,24 @@ void WordWaffleFinder<MapT>::initRowsAndCols()
         this->mRowNodes[row][-1] =  this->mOddRowTrie.getRoot();
     }
 
-    // For each column, make colNodes[col] point to the start of the column,
-    // which is one pointer address *after* the column's raw memory start, 
-    // and make colNodes[col][-1] point to the mColTrie root.
-    this->mColNodesMem = (const TrixNode  **) new TrixNode*[this->mWantWide * tallP1];
-    // Re-init the even col node arrays.
-    for (int col = 0; col < this->mWantWide; col += 2) {
-        this->mColNodes[col]     = &this->mColNodesMem[col * tallP1 + 1];
-        this->mColNodes[col][-1] = this->mColTrie.getRoot();
+    // Row-major column frontier, as in WordRectFinder::initRowsAndCols, but with 
+    // the even and odd columns starting from different roots, in two rows above 
+    // row 0.  A whole row takes each even column's node from the minor row above
+    // it, at col/2, and each odd column's node from the whole row above that, at
+    // col; so row -1 is a minor row of even column roots, and row -2 a whole row 
+    // with the odd column roots, and row 0 is searched like any other whole row.
+    this->mColFrontMem = (const RectNode  **) new RectNode*[this->mWantWide * tallP2];
+    for (int row = -2; row < this->mWantTall; row++) {
+        this->mColFrontRows[row + 2] = &this->mColFrontMem[(row + 2) * this->mWantWide];
     }
-    // Re-init the odd col node arrays.
+    this->mColFront = this->mColFrontRows + 2;
+    // Init the even col roots.
+    for (int col = 0; col < mOddWide; col++) {
+        this->mColFront[-1][col] = this->mColTrie.getRoot();
+    }
+    // Init the odd col roots.
     for (int col = 1; col < this->mWantWide; col += 2) {
-        this->mColNodes[col]     = &this->mColNodesMem[col * tallP1 + 1];
-        this->mColNodes[col][-1] = this->mOddColTrie.getRoot();
+        this->mColFront[-2][col] = this->mOddColTrie.getRoot();
     }
 }
 
@@ -55,10 +61,118 @@ void WordWaffleFinder<MapT>::initRowsAndCols()
 template <typename MapT>
 int WordWaffleFinder<MapT>::findWordRows()
 {
-
     if (this->mUseAltA)
-        return findWordRowsUsingTrieLinksA(0);
-    return     findWordRowsUsingTrieLinks(0);
+        return findWordRowsUsingTrieLinks(0);
+    if (this->mWantTall % 2)
+        return findWaffleRows<true, true>(0);
+    return     findWaffleRows<true, false>(0);
+}
+
+
+/**
+* The waffle search, one row per call, with the parity of the row and of the columns' 
+* length as template parameters.  EvnRow means haveTall is even, so the row to add is 
+* a whole row of mWantWide letters; otherwise it is a minor row of mOddWide letters, one 
+* under each even column.  OddTall means mWantTall is odd, so the rows are done when
+* haveTall is odd: the check for success is only compiled into the two variants where 
+* EvnRow != OddTall.  Each call makes the next as findWaffleRows<!EvnRow, OddTall>, 
+* directly, so the compiler can inline one variant into the other.
+*
+* This is the same search, node for node, as findWordRowsUsingTrieLinks, which checks 
+* these parities at each row and each letter.  In a whole row, the column parity still 
+* picks where each column's node is, but the loop takes the letters two at a time, an 
+* even column and then an odd one, so it only checks where to start, once per pair.
+*/
+template <typename MapT>
+template <bool EvnRow, bool OddTall>
+int WordWaffleFinder<MapT>::findWaffleRows(int haveTall)
+{
+    this->mNowTall = haveTall;
+    if (haveTall > 1 && this->mWantArea <= WordRectSearchMgr<MapT>::getTrumpingArea()) {
+        this->mState = WordRectFinder<MapT>::eAborted;
+        return -this->mMaxTall;  // Abort because a wordRect bigger than wantArea has been found
+    }
+    if (this->isPastDeadline()) {
+        this->mState = WordRectFinder<MapT>::eTimedOut;
+        return -this->mMaxTall;  // Abort because this finder's time is up
+    }
+    if (EvnRow != OddTall && haveTall == this->mWantTall) {
+        return this->recordFoundRect(haveTall);     // Success: the row just added made words of all columns.
+    }
+
+    const WordTrie<MapT, RectNode>& rowTrie = EvnRow ? mEvnRowTrie : mOddRowTrie;
+    const RectNode *rowWordNode = NULL;
+    if (EvnRow && haveTall == 0) {
+        rowWordNode = rowTrie.getFirstWordNode();
+    } else {
+        rowWordNode = rowTrie.getFirstWordNodeFromIndex(this->rowCharIndex(this->mColFront[haveTall-1][0]->getLetterAt(haveTall)));
+        if (this->mMaxTall < haveTall)
+            this->recordDeeperRows(haveTall);
+    }
+
+    // In a whole row, an even column's node is in the minor row above, at col/2, and an odd
+    // column's is in the whole row above that, at col.  In a minor row, the node for each col
+    // is that of column col*2, in the whole row above.
+    const int lastCol = EvnRow ? this->mWantWideM1 : mOddWide - 1;
+    const RectNode **rowNodes = this->mRowNodes[haveTall], *nextStem;
+    const RectNode **colNodes = this->mColFront[haveTall];
+    const RectNode **colAbove = this->mColFront[haveTall-1];
+    const RectNode **colAbove2 = EvnRow ? this->mColFront[haveTall-2] : NULL;
+    for (int col = 0; rowWordNode != NULL; ) {
+        const char *rowWord = rowWordNode->getStem();  // Not getWord(), because we already know that rowWordNode is a word-node
+        for (;;) {
+            if (EvnRow) {
+                if (col % 2 == 0) {
+                    if ( ! addRowLetter(rowNodes, colNodes, col, rowWord[col], colAbove[col/2]))
+                        break;                  // No column word goes on through this letter, so get the next word.
+                    if (col == lastCol) {
+                        int area = findNextWaffleRows<EvnRow, OddTall>(haveTall, rowWord);
+                        if (area != 0)
+                            return area;
+                        break;
+                    }
+                    col++;
+                }
+                if ( ! addRowLetter(rowNodes, colNodes, col, rowWord[col], colAbove2[col]))
+                    break;
+            } else {
+                if ( ! addRowLetter(rowNodes, colNodes, col, rowWord[col], colAbove[col*2]))
+                    break;
+            }
+            if (col == lastCol) {
+                int area = findNextWaffleRows<EvnRow, OddTall>(haveTall, rowWord);
+                if (area != 0)
+                    return area;
+                break;
+            }
+            col++;
+        }
+        // This word failed at column col, here or deeper down, so try the first word whose
+        // col-letter stem is greater than this word's, as findWordRowsUsingTrieLinks does.
+        nextStem = rowNodes[col]->getNextStemNode();
+        if (nextStem == NULL) {
+            return 0;   // We've tried all possible word stems for the partial columns we got, so return. 
+        }
+        col = nextStem->getDepth() - 1;
+        rowWordNode = nextStem->getFirstWordNode();
+    }
+    return 0;   // Failure: No wantWide x wantTall word waffle at the end of this path
+}
+
+/**
+* At least one wantTall-length word exists to complete each column, including this row,
+* so try adding another row.  Returns the area if that found enough waffles, or a negative
+* number if it is aborting, to return up through the stack; or 0 to try the next word.
+*/
+template <typename MapT>
+template <bool EvnRow, bool OddTall>
+inline int WordWaffleFinder<MapT>::findNextWaffleRows(int haveTall, const char *rowWord)
+{
+    this->mRowWordsNow[haveTall] = rowWord;
+    int area = findWaffleRows<!EvnRow, OddTall>(haveTall+1);
+    if (area < 0 || (area > 0 && this->getNumFound() == this->getNumToFind()))
+        return area;
+    return 0;
 }
 
 
@@ -70,24 +184,28 @@ int WordWaffleFinder<MapT>::findWordRowsUsingTrieLinks(int haveTall)
         this->mState = WordRectFinder<MapT>::eAborted;
         return -this->mMaxTall;  // Abort because a wordRect bigger than wantArea has been found
     }
+    if (this->isPastDeadline()) {
+        this->mState = WordRectFinder<MapT>::eTimedOut;
+        return -this->mMaxTall;  // Abort because this finder's time is up
+    }
 
     bool evenRow = true;
     bool evenCol = true;
     int prevTall = haveTall - 1;              // prevTall == -1 is ok.
     int lastCol  = this->mWantWideM1;
-    const TrixNode *rowWordNode = NULL;
+    const RectNode *rowWordNode = NULL;
     if (haveTall == 0) {
         rowWordNode = this->mRowTrie.getFirstWordNode();
     } else if (haveTall < this->mWantTall) {
         if (haveTall % 2 == 0) {
-            rowWordNode = this->mEvnRowTrie.getFirstWordNodeFromIndex(this->rowCharIndex(this->mColNodes[0][prevTall]->getLetterAt(haveTall)));
+            rowWordNode = this->mEvnRowTrie.getFirstWordNodeFromIndex(this->rowCharIndex(this->mColFront[prevTall][0]->getLetterAt(haveTall)));
         } else {
-            rowWordNode = this->mOddRowTrie.getFirstWordNodeFromIndex(this->rowCharIndex(this->mColNodes[0][prevTall]->getLetterAt(haveTall)));
+            rowWordNode = this->mOddRowTrie.getFirstWordNodeFromIndex(this->rowCharIndex(this->mColFront[prevTall][0]->getLetterAt(haveTall)));
             evenRow = false;
             lastCol = mOddWide - 1;
         }
         if (this->mMaxTall < haveTall)
-            this->mMaxTall = haveTall;
+            this->recordDeeperRows(haveTall);
     } else {
         // Success: the row just added made words of all columns.
         // Record it right now, right here.
@@ -127,7 +245,7 @@ int WordWaffleFinder<MapT>::findWordRowsUsingTrieLinks(int haveTall)
     Odd Col:  candidate rowWord[col] must be a branch of colNode[col][row-2]
     */
     const char *rowWord;
-    const TrixNode **rowNodes = this->mRowNodes[haveTall], *colBranch, *nextStem;
+    const RectNode **rowNodes = this->mRowNodes[haveTall], *colBranch, *nextStem;
     for (int col = 0; rowWordNode != NULL; ) {
         rowWord = rowWordNode->getStem();  // Not getWord(), because we already know that rowWordNode is a word-node
         for (;;) {
@@ -138,20 +256,18 @@ int WordWaffleFinder<MapT>::findWordRowsUsingTrieLinks(int haveTall)
 
             //  We'll need colBranch later only if it is non-NULL.
             if (evenRow) {
-                if (haveTall == 0) {
-                    colBranch = this->mColNodes[col][-1]->getBranchAtIndex(this->colCharIndex(rowWord[col]));
-                } else if (evenCol) {
-                    colBranch = this->mColNodes[col/2][prevTall]->getBranchAtIndex(this->colCharIndex(rowWord[col]));
+                if (evenCol) {
+                    colBranch = this->mColFront[prevTall][col/2]->getBranchAtIndex(this->colCharIndex(rowWord[col]));
                 } else {
-                    colBranch = this->mColNodes[col][prevTall-1]->getBranchAtIndex(this->colCharIndex(rowWord[col]));
+                    colBranch = this->mColFront[prevTall-1][col]->getBranchAtIndex(this->colCharIndex(rowWord[col]));
                 }
             } else {                
-                colBranch = this->mColNodes[col*2][prevTall]->getBranchAtIndex(this->colCharIndex(rowWord[col]));
+                colBranch = this->mColFront[prevTall][col*2]->getBranchAtIndex(this->colCharIndex(rowWord[col]));
             }
             if (colBranch == NULL) {
                 break;                              // ...if not, break to get the next word.
             }
-            this->mColNodes[col][haveTall] = colBranch;      // ...if so, add the branch node and continue.
+            this->mColFront[haveTall][col] = colBranch;      // ...if so, add the branch node and continue.
             if (col == lastCol) {
                 // At least one wantTall-length word exists to complete each column, including this row,
                 this->mRowWordsNow[haveTall] = rowWord;                                 // so try adding another row.
@@ -193,13 +309,13 @@ bool WordWaffleFinder<MapT>::isSymmetricSquare() const
         return false;                           // not square
     for (int row = 0; row < this->mWantTall; ++row) {
         for (int col = this->mWantWide; --col >= 0; ) {
-            if (this->mRowNodes[row][col] != this->mColNodes[row][col])
+            if (this->mRowNodes[row][col] != this->mColFront[col][row])
                 return false;                   // not symmetric
         }
         if (++row == this->mWantTall)
             break;
         for (int col = 0; col < this->mWantWide; col += 2) {
-            if (this->mRowNodes[row][col] != this->mColNodes[row][col])
+            if (this->mRowNodes[row][col] != this->mColFront[col][row])
                 return false;                   // not symmetric
         }
     }
@@ -213,13 +329,13 @@ void WordWaffleFinder<MapT>::printWordRows(const char *wordRows[], int haveTall)
 {
     for (int row = 0; row < haveTall; ++row) {
         for (const char *pc = wordRows[row]; *pc != '\0'; pc++) {
-            printf(" %c", *pc);
+            printf(" %s", CodePointMap::getText(*pc));
         }
         printf("\n");
         if (++row == haveTall)
             break;
         for (const char *pc = wordRows[row]; *pc != '\0'; pc++) {
-            printf(" %c  ", *pc);
+            printf(" %s  ", CodePointMap::getText(*pc));
         }
         printf("\n");
     }
@@ -24,25 +24,15 @@ template <typename MapT>
 class WordWaffleFinder : public WordRectFinder<MapT>
 {
 public:
-    typedef int (WordWaffleFinder::*rowFinderFn)(int);
-
-    WordWaffleFinder(WordTrie<MapT, TrixNode> *wordTries[], const WordMap *maps, int wide, int tall, int numToFind, uint options) 
-        : WordRectFinder<MapT>(wordTries, maps, wide, tall, numToFind, options)
+    WordWaffleFinder(WordTrie<MapT, RectNode> *wordTries[], const WordArray *arrays, int wide, int tall, int numToFind, uint options) 
+        : WordRectFinder<MapT>(wordTries, arrays, wide, tall, numToFind, options)
         , mOddWide((wide + 1) / 2)
         , mOddTall((tall + 1) / 2)
         , mEvnRowTrie(*wordTries[wide])
         , mEvnColTrie(*wordTries[tall])
         , mOddRowTrie(*wordTries[mOddWide])
         , mOddColTrie(*wordTries[mOddTall])
-    { 
-        if (tall % 2) {	// gcc requires mWantTall to be qualified: WordRectFinder<MapT>::mWantTall
-            mOddRowFinder = &WordWaffleFinder::findOddRowWantingOddTotal;
-            mEvnRowFinder = &WordWaffleFinder::findEvnRowWantingOddTotal;
-        } else { 
-            mOddRowFinder = &WordWaffleFinder::findOddRowWantingEvnTotal;
-            mEvnRowFinder = &WordWaffleFinder::findEvnRowWantingEvnTotal;
-        }
-    }
+    { }
 
     WordWaffleFinder(const WordWaffleFinder&);              // Prevent pass-by-value by not defining this copy constructor.
     WordWaffleFinder& operator=(const WordWaffleFinder&);   // Prevent assignment by not defining this operator.
@@ -55,19 +45,22 @@ private:
     virtual int  findWordRowsUsingTrieLinks(int haveTall);
     int          findWordColsUsingTrieLinks(int row, int col);
 
-    int			 findWordRowsUsingTrieLinksA(int haveTall);
-
-    int			 findWordRowsUsingTrieLinksOddA(int haveTall);
-    int			 findWordRowsUsingTrieLinksEvnA(int haveTall);
+    template <bool EvnRow, bool OddTall>
+    int          findWaffleRows(int haveTall);
+    template <bool EvnRow, bool OddTall>
+    int          findNextWaffleRows(int haveTall, const char *rowWord);
 
-    int			 findFirstWordRow();
-    int			 findOddRowWantingOddTotal(int haveTall);
-    int			 findOddRowWantingEvnTotal(int haveTall);
-    int			 findEvnRowWantingOddTotal(int haveTall);
-    int			 findEvnRowWantingEvnTotal(int haveTall);
-
-    int			 findNextEvnRow(int haveTall);
-    int			 findNextOddRow(int haveTall);
+    /**
+    * Add the letter of a row word at col: its node in the row, and its column's node through
+    * it, branching from colNode, the column's node in the rows above.  Returns false if no
+    * column word goes on through this letter.
+    */
+    inline bool  addRowLetter(const RectNode **rowNodes, const RectNode **colNodes, int col, uchr letter, const RectNode *colNode)
+    {
+        rowNodes[col] = rowNodes[col-1]->getBranchAtIndex(this->rowCharIndex(letter));
+        colNodes[col] = colNode->getBranchAtIndex(this->colCharIndex(letter));
+        return colNodes[col] != NULL;
+    }
 
     virtual bool isSymmetricSquare() const;
     virtual void printWordRows(const char *wordRows[], int haveTall) const;
@@ -75,13 +68,10 @@ private:
 protected:
     const int          mOddWide;
     const int          mOddTall;
-    const WordTrie<MapT, TrixNode> &mEvnRowTrie;
-    const WordTrie<MapT, TrixNode> &mEvnColTrie;
-    const WordTrie<MapT, TrixNode> &mOddRowTrie;
-    const WordTrie<MapT, TrixNode> &mOddColTrie;
-
-    rowFinderFn         mOddRowFinder;
-    rowFinderFn         mEvnRowFinder;
+    const WordTrie<MapT, RectNode> &mEvnRowTrie;
+    const WordTrie<MapT, RectNode> &mEvnColTrie;
+    const WordTrie<MapT, RectNode> &mOddRowTrie;
+    const WordTrie<MapT, RectNode> &mOddColTrie;
 };
 
 #endif // WordWaffleFinder_hpp
\ No newline at end of file
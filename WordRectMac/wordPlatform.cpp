@@ -6,6 +6,71 @@
 #include "wordPlatform.h"
 #include <unistd.h>
 
+#ifdef _MBCS	// Microsoft Compiler
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+struct WorkerThreadArgs { WorkerFunc mWork; void *mArgs; };
+
+#ifdef _MBCS
+static DWORD WINAPI workerThreadProc(LPVOID pv)
+{
+    WorkerThreadArgs *pWTA = (WorkerThreadArgs *)pv;
+    pWTA->mWork(pWTA->mArgs);
+    return 0;
+}
+#else
+static void * workerThreadProc(void *pv)
+{
+    WorkerThreadArgs *pWTA = (WorkerThreadArgs *)pv;
+    pWTA->mWork(pWTA->mArgs);
+    return NULL;
+}
+#endif
+
+int runWorkerThreads(WorkerFunc work, void *args[], int numWorkers)
+{
+    int numStarted = 0;
+    WorkerThreadArgs *threadArgs = new WorkerThreadArgs[numWorkers];
+#ifdef _MBCS
+    HANDLE *threads = new HANDLE[numWorkers];
+#else
+    pthread_t *threads = new pthread_t[numWorkers];
+#endif
+    bool *started = new bool[numWorkers];
+    for (int j = 0; j < numWorkers; j++) {
+        threadArgs[j].mWork = work;
+        threadArgs[j].mArgs = args[j];
+#ifdef _MBCS
+        threads[j] = CreateThread(NULL, 0, workerThreadProc, &threadArgs[j], 0, NULL);
+        started[j] = (threads[j] != NULL);
+#else
+        started[j] = (pthread_create(&threads[j], NULL, workerThreadProc, &threadArgs[j]) == 0);
+#endif
+        if (started[j])
+            numStarted++;
+        else
+            work(args[j]);
+    }
+    for (int j = 0; j < numWorkers; j++) {
+        if ( ! started[j])
+            continue;
+#ifdef _MBCS
+        WaitForSingleObject(threads[j], INFINITE);
+        CloseHandle(threads[j]);
+#else
+        pthread_join(threads[j], NULL);
+#endif
+    }
+    delete [] started;
+    delete [] threads;
+    delete [] threadArgs;
+    return numStarted;
+}
+
 #ifdef _MBCS	// Microsoft Compiler
 
 #else
@@ -19,7 +84,8 @@ int GetLastError() { return -1; }
 
 void GetSystemInfo(SYSTEM_INFO *pSysInfo)
 {
-    pSysInfo->dwNumberOfProcessors = 2;
+    long numProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+    pSysInfo->dwNumberOfProcessors = numProcessors > 0 ? (DWORD)numProcessors : 2;
 }
 
 #define CTIME_BUFSIZE 64
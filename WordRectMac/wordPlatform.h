@@ -68,7 +68,13 @@ void    GetSystemInfo(SYSTEM_INFO *pSysInfo);
 
 #endif	// _MBCS
 
-
+/**
+* Call work(args[j]) for each of the numWorkers args, each in its own thread (Windows or
+* POSIX threads), and wait for them all to finish.  If a thread cannot be started, its
+* work is done in the calling thread instead.  Returns the number of threads started.
+*/
+typedef void (*WorkerFunc)(void *pvArgs);
+int     runWorkerThreads(WorkerFunc work, void *args[], int numWorkers);
 
 
 #endif  // wordPlatform_h
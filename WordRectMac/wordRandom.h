@@ -0,0 +1,45 @@
+// wordRandom.h : Small, fast, seedable pseudo-random numbers for randomized searches
+
+#ifndef wordRandom_h
+#define wordRandom_h
+
+#include "wordTypes.h"
+
+/**
+*  Marsaglia's xorshift64* generator: good enough for shuffling and sampling,
+*  and each finder can own one, so no locking and no shared state.
+*  Equal seeds give equal sequences, which keeps randomized runs reproducible.
+*/
+class WordRandom
+{
+public:
+    explicit WordRandom(uint64 seed = 1) { setSeed(seed); }
+
+    inline void     setSeed(uint64 seed)    { mState = seed != 0 ? seed : 0x9E3779B97F4A7C15ULL; }  // state must not be 0
+
+    /** The seed for a search of one wide * tall shape, so every randomized part of that search (estimator,
+        orientation probes, sampler, shufflers) starts from the same place; salt tells apart, e.g., the shufflers. */
+    static inline uint64 shapeSeed(uint wide, uint tall, uint salt = 0)
+    {
+        return ((uint64)salt << 32 | (uint64)wide << 16 | (uint64)tall) * 0x9E3779B97F4A7C15ULL;
+    }
+
+    inline uint64   next()
+    {
+        mState ^= mState >> 12;
+        mState ^= mState << 25;
+        mState ^= mState >> 27;
+        return mState * 0x2545F4914F6CDD1DULL;
+    }
+
+    /** Uniform in [0, bound), for bound > 0 */
+    inline uint     below(uint bound)       { return (uint)(((next() >> 32) * bound) >> 32); }
+
+    /** Uniform in [0.0, 1.0) */
+    inline double   unit()                  { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+
+private:
+    uint64          mState;
+};
+
+#endif  // wordRandom_h
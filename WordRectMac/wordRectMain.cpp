@@ -33,7 +33,7 @@ static const uint  defNumTotal  =  0;
 
 static void usage(int argc, const char* argv[], const char *reason=NULL)
 {
-    printf( "\n  Usage: %s [-ahilmoqswz] [-dDictionary] [-vVerbosity] [minArea minHeight maxHeight maxArea minCharC numEach numTotal]\n", sProgramName);
+    printf( "\n  Usage: %s [-ahilmnopqswz] [-bSeconds] [-dDictionary] [-fDepth] [-gPatterns] [-GGrid] [-jResultsFile] [-kNumProbes] [-NWords] [-rNumRandom] [-R[Side]] [-uNumSamples] [-vVerbosity] [minArea minHeight maxHeight maxArea minCharC numEach numTotal]\n", sProgramName);
     printf( "All arguments are optional.  If they conflict (q & v, or m & w), the last one wins.\n"
         "  The defaults are the minimum and maximum values the program accepts:\n"
         "    %d %d %d %d.\n", defMinArea, defMinTall, defMaxTall, defMaxArea);
@@ -42,19 +42,51 @@ static void usage(int argc, const char* argv[], const char *reason=NULL)
         , defMinTall, defMinTall, defMinArea, defMaxTall, defMaxTall, defMaxArea);
     printf( "using linked tries to check column words to find the next candidate for each word row.\n\n"
         "The letter options are:\n");
-    printf( "-a   Use alternative search algorithm (might be faster).\n");
+    printf( "-a   Use alternative search algorithm (waffles only: the same search, without the\n");
+    printf( "     row finders specialized for each row and column parity, to check them against).\n");
+    printf( "-bN  Anytime mode: stop searching after N seconds, and report the largest rect found\n"
+        "     and the deepest partial rect for each size tried.  Rects (not lattices or waffles)\n"
+        "     are searched by limited discrepancy, best guesses first.\n");
     printf( "-d   Use the next argument for the dictionary file name (instead of %s).\n", defDictFile);
     printf( "-e   Try to find at least one rect for each eligible wide-tall pair.\n");
+    printf( "-fN  Find the first N rows (default 2) just once for each width, for all the heights\n"
+        "     in range, and start each rect finder from them (plain rects and -n only).\n");
+    printf( "-gP  Instead of searching, list the dictionary words matching each of the comma-separated\n"
+        "     patterns P, where ? is any letter and [abc] or [^abc] is any letter listed or not, as in\n"
+        "     -gc?o?s??d,qu[ai]ck (quote P for the shell).  With -q, only count them.\n");
+    printf( "-GG  Fill grids instead of rects: the one masked in the file G, one row of cells per line,\n"
+        "     with . for an open cell, # for a blocked one, and + for a blocked one that words read\n"
+        "     through, as in a crossword; or, if G is rect, lattice, or waffle, that pattern in each\n"
+        "     size in range.  Every run of 2 or more open cells across or down must be a word.\n");
     printf( "-h   Show this help message.\n");
     printf( "-i   Order the search for word rectangles in increasing order (slower but fun).\n"
         "     The default is to order the search by decreasing area, so it can end when the"
         "     first (largest) is found.\n");
+    printf( "-jF  Keep what each search decides (the rects found, or a proof that there are none)\n"
+        "     in the file F, by dictionary and size, and skip the sizes it already decided.\n");
+    printf( "-kN  Estimate, without searching, the number of search nodes, complete rects, and seconds\n"
+        "     for each rect size in range, using N random probes per size (Knuth's method).\n");
     printf( "-l   Find word lattices instead of word rectangles\n");
-    printf( "-m   Use std::map::upper_bound instead of tries to find rows (rects only, much slower).\n");
+    printf( "-m   Find rows in sorted arrays of words instead of tries (rects only, not with -R).  The\n"
+        "     same search by other means, to check the tries against, in about 2.5 times the time.\n");
+    printf( "-n   Count all word rects of each size, without printing them or stopping early.\n"
+        "     Sets -e.  With -v3 or more, also shows the count for each first row word.\n");
+    printf( "-NW  Instead of searching, list the (up to 10) dictionary words nearest to each of the\n"
+        "     comma-separated words W, within 2 chars inserted, deleted, changed, or swapped.\n");
     printf( "-o   Odd dimensions only: search only for rectangles of odd widths and heights.\n");
+    printf( "-p   Prune the dictionary for each rect size before searching it: drop the row and column\n"
+        "     words whose letters cannot meet any column or row word (rects only, also with -k, -n, -u).\n");
     printf( "-q   Quiet mode (Verbosity=1).  Omit most of the messages about finder-threads.\n");
+    printf( "-rK  Randomized restarts: search each rect size with K finders, each trying letters\n"
+        "     in its own shuffled order and restarting on a Luby schedule (rects only).\n");
+    printf( "-R   Also load the dictionary spelled backwards, and fill each rect from the side where its\n"
+        "     words constrain it most, as estimated by random probes (rects only, also with -n).\n"
+        "     -Rt, -Rb, -Rl, or -Rr fills every rect from the top, bottom, left, or right instead.\n");
     printf( "-s   Single-threaded mode; not using a pool of parallel worker threads\n");
     printf( "-s   Single-threaded mode; not using a pool of parallel worker threads\n");
+    printf( "-uN  Count all word rects of each size up to 4 rows high, by dynamic programming over\n"
+        "     the columns' trie states (faster than -n, by far when there are many), and show N\n"
+        "     of them chosen uniformly at random.\n");
     printf( "-vN  Verbosity level = N [0 - 9].\n");
     printf( "-z   Find ALL MAXIMAL word rectangles in the specified range, instead of only\n"
         "     one for each possibly maximal total area.  If a larger word rect is found,\n"
@@ -88,6 +120,16 @@ int wordRectMain(int argc, const char* argv[])
     sint tmpSint = 0;
     uint argUintC = 0, argUintV[MAX_ARG_UINT_COUNT] = { 0, };
     uint verbosity = 2;
+    uint timeBudget = 0;
+    uint numShufflers = 0;
+    uint numProbes = 0;
+    uint numSamples = 0;
+    uint frontierDepth = 0;
+    const char *resultsFileName = NULL;
+    const char *patterns = NULL;
+    const char *nearWords = NULL;
+    const char *gridMask = NULL;
+    RectOrientation orientation = eBestSideFirst;
     uint managerFlags = WordRectSearchExec::eDefaultZero | WordRectSearchExec::eAbortIfTrumped;
 
     if (argv[0])
@@ -104,6 +146,16 @@ int wordRectMain(int argc, const char* argv[])
                     case 'a' :
                         managerFlags |= WordRectSearchExec::eUseAltAlg;
                         break;
+                    case 'b' :
+                        tmpSint = atoi(++pc);
+                        if (tmpSint > 0) {
+                            timeBudget = tmpSint;
+                        } else {
+                            sprintf_safe(reason, MSG_SIZE, "-b option not followed immediately by time budget in seconds");
+                            usage(argc, argv, reason);
+                        }
+                        goto NEXT_ARG;
+                        break;
                     case 'c' :
                         // TODO: use compact array map
                         break;
@@ -118,30 +170,113 @@ int wordRectMain(int argc, const char* argv[])
                     case 'e' :
                         managerFlags &= ~WordRectSearchExec::eAbortIfTrumped;
                         break;
+                    case 'f' :
+                        if (pc[1] < '0' || '9' < pc[1]) {
+                            frontierDepth = 2;  // -f without a number means the default depth
+                            break;
+                        }
+                        tmpSint = atoi(++pc);
+                        if (1 <= tmpSint && tmpSint <= 8) {
+                            frontierDepth = tmpSint;
+                        } else {
+                            sprintf_safe(reason, MSG_SIZE, "-f option followed by a depth not in [1-8]");
+                            usage(argc, argv, reason);
+                        }
+                        goto NEXT_ARG;
+                        break;
+                    case 'N' :
+                        if ( *(++pc) == '\0') {
+                            sprintf_safe(reason, MSG_SIZE, "-N option not followed immediately by words");
+                            usage(argc, argv, reason);
+                        }
+                        nearWords = pc;
+                        goto NEXT_ARG;
+                    case 'g' :
+                        if ( *(++pc) == '\0') {
+                            sprintf_safe(reason, MSG_SIZE, "-g option not followed immediately by word patterns");
+                            usage(argc, argv, reason);
+                        }
+                        patterns = pc;
+                        goto NEXT_ARG;
+                    case 'G' :
+                        if ( *(++pc) == '\0') {
+                            sprintf_safe(reason, MSG_SIZE, "-G option not followed immediately by grid file-spec or pattern");
+                            usage(argc, argv, reason);
+                        }
+                        gridMask = pc;
+                        goto NEXT_ARG;
                     case 'h' : 
                         usage(argc, argv, "help was requested (-h)");
                         break;
                     case 'i' :
                         managerFlags |= WordRectSearchExec::eIncreasingSize;
                         break;
+                    case 'j' :
+                        if ( *(++pc) == '\0') {
+                            sprintf_safe(reason, MSG_SIZE, "-j option not followed immediately by results file-spec");
+                            usage(argc, argv, reason);
+                        }
+                        resultsFileName = pc;
+                        goto NEXT_ARG;
+                        break;
+                    case 'k' :
+                        tmpSint = atoi(++pc);
+                        if (tmpSint >= 2) {
+                            numProbes = tmpSint;
+                        } else {
+                            sprintf_safe(reason, MSG_SIZE, "-k option not followed immediately by number of probes >= 2");
+                            usage(argc, argv, reason);
+                        }
+                        goto NEXT_ARG;
+                        break;
                     case 'l' :
                         managerFlags |= WordRectSearchExec::eFindLattices;
                         break;
                     case 'm' :
-                        managerFlags |= WordRectSearchExec::eUseMaps;
+                        managerFlags |= WordRectSearchExec::eUseArrays;
+                        break;
+                    case 'n' :
+                        managerFlags |= WordRectSearchExec::eCountOnly;
                         break;
                     case 'o' :
                         managerFlags |= WordRectSearchExec::eOnlyOddDims;
                         break;
+                    case 'p' :
+                        managerFlags |= WordRectSearchExec::ePruneShapes;
+                        break;
                     case 'q' :
                         verbosity = 1;
                         break;
+                    case 'r' :
+                        tmpSint = atoi(++pc);
+                        if (1 <= tmpSint && tmpSint <= (sint)WordRectSearchExec::sHardMaxFinders) {
+                            numShufflers = tmpSint;
+                        } else {
+                            sprintf_safe(reason, MSG_SIZE, "-r option not followed immediately by a number [1-%d]", WordRectSearchExec::sHardMaxFinders);
+                            usage(argc, argv, reason);
+                        }
+                        goto NEXT_ARG;
+                        break;
+                    case 'R' :
+                        managerFlags |= WordRectSearchExec::eOrientShapes;
+                        switch (pc[1]) {    // -R alone means the best side for each shape
+                            case 't' :  orientation = eTopRowFirst;     ++pc;   break;
+                            case 'b' :  orientation = eBottomRowFirst;  ++pc;   break;
+                            case 'l' :  orientation = eLeftColFirst;    ++pc;   break;
+                            case 'r' :  orientation = eRightColFirst;   ++pc;   break;
+                        }
+                        break;
                     case 's' :
                         managerFlags |= WordRectSearchExec::eSingleThreaded;
                         break;
                     case 't' :
                         managerFlags |= WordRectSearchExec::eTryTracNodes;
                         break;
+                    case 'u' :
+                        managerFlags |= WordRectSearchExec::eCountByStates;
+                        numSamples = atoi(++pc);    // -u alone means no samples
+                        goto NEXT_ARG;
+                        break;
                     case 'v' :
                         tmpSint = atoi(++pc);
                         if (1 <= tmpSint && tmpSint <= 9) {
@@ -201,8 +336,8 @@ int wordRectMain(int argc, const char* argv[])
     numEach = argUintC > 5 ? argUintV[5] : defNumEach;
     numTot  = argUintC > 6 ? argUintV[6] : defNumTotal;
 
-    const char *mapsOrTries = managerFlags & WordRectSearchExec::eUseMaps ? "maps" : "tries";
-    printf("%s: using %s,\n", sProgramName, mapsOrTries);
+    const char *arraysOrTries = managerFlags & WordRectSearchExec::eUseArrays ? "word arrays" : "tries";
+    printf("%s: using %s,\n", sProgramName, arraysOrTries);
     printf("   min & max Area: %d %d, min & max Height: %d %d.\n", minArea, maxArea, minTall, maxTall);
     if (minArea > maxArea || minTall > maxTall) {
         usage(argc, argv, "minArea > maxArea or minHeight > maxHeight");
@@ -217,6 +352,16 @@ int wordRectMain(int argc, const char* argv[])
     
     WordRectSearchExec& searchExec = WordRectSearchExec::getInstance();
     searchExec.setOptions(managerFlags, minChrC, minWordLength, maxWordLength, verbosity);
+    searchExec.setTimeBudget(timeBudget);
+    searchExec.setNumShuffleFinders(numShufflers);
+    searchExec.setNumProbes(numProbes);
+    searchExec.setOrientation(orientation);
+    searchExec.setNumSamples(numSamples);
+    searchExec.setFrontierDepth(frontierDepth);
+    searchExec.setResultsFile(resultsFileName);
+    searchExec.setPatterns(patterns);
+    searchExec.setNearWords(nearWords);
+    searchExec.setGridMask(gridMask);
     searchExec.startupSearchManager(dictFileName, minArea, minTall, maxTall, maxArea, numEach, numTot);
     searchExec.destroySearchManager();
     WordRectSearchExec::deleteInstance();
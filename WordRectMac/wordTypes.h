@@ -10,6 +10,7 @@ typedef   signed char schr;	// But avoid using signed char for letters
 typedef unsigned char uchr;
 typedef   signed int  sint;
 typedef unsigned int  uint;
+typedef unsigned long long uint64;	// search node counts
 
 #ifdef _DEBUG
 #include <assert.h>